@@ -0,0 +1,50 @@
+#include "benchmark/benchmark_api.h"
+#include "aviio.h"
+
+#include <cstdio>
+#include <cstring>
+
+// a screen-like frame with flat areas, ramps and some noise
+static void fill_frame(bitmap_yuy16 &bitmap)
+{
+	uint32_t seed = 12345;
+	for (int y = 0; y < bitmap.height(); y++)
+		for (int x = 0; x < bitmap.width(); x++)
+		{
+			seed = seed * 1103515245 + 12345;
+			uint16_t pixel = (((x / 32) * 0x23 + (y / 16) * 0x11) << 8) | 0x80;
+			if ((x / 64 + y / 64) % 5 == 0)
+				pixel = ((x & 0xff) << 8) | ((y + (seed >> 28)) & 0xff);
+			bitmap.pix16(y, x) = pixel;
+		}
+}
+
+static void BM_avi_append_video_frame(benchmark::State& state) {
+	avi_file::movie_info info;
+	memset(&info, 0, sizeof(info));
+	info.video_format = state.range(2);
+	info.video_timescale = 60;
+	info.video_sampletime = 1;
+	info.video_width = state.range(0);
+	info.video_height = state.range(1);
+	info.video_depth = 16;
+	info.audio_samplebits = 16;
+
+	bitmap_yuy16 bitmap(state.range(0), state.range(1));
+	fill_frame(bitmap);
+	char const *const filename = "avi_benchmark.avi";
+	{
+		avi_file::ptr file;
+		avi_file::create(filename, info, file);
+		while (state.KeepRunning()) {
+			file->append_video_frame(bitmap);
+		}
+	}
+	std::remove(filename);
+	state.SetItemsProcessed(state.iterations());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_avi_append_video_frame)
+	->Args({ 320, 240, FORMAT_YUY2 })->Args({ 320, 240, FORMAT_HFYU })
+	->Args({ 640, 480, FORMAT_YUY2 })->Args({ 640, 480, FORMAT_HFYU })
+	->Args({ 1920, 1080, FORMAT_YUY2 })->Args({ 1920, 1080, FORMAT_HFYU });
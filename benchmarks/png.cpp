@@ -0,0 +1,34 @@
+#include "benchmark/benchmark_api.h"
+#include "png.h"
+
+#include <cstdio>
+
+// a screen-like image with flat areas, gradients and some noise
+static void fill_bitmap(bitmap_rgb32 &bitmap)
+{
+	uint32_t seed = 12345;
+	for (int y = 0; y < bitmap.height(); y++)
+		for (int x = 0; x < bitmap.width(); x++)
+		{
+			seed = seed * 1103515245 + 12345;
+			uint32_t pixel = ((x / 32) * 0x102030) ^ ((y / 16) * 0x030201);
+			if ((x / 64 + y / 64) % 5 == 0)
+				pixel = ((x & 0xff) << 16) | ((y & 0xff) << 8) | ((seed >> 24) & 0x0f);
+			bitmap.pix32(y, x) = pixel;
+		}
+}
+
+static void BM_png_write(benchmark::State& state) {
+	bitmap_rgb32 bitmap(state.range(0), state.range(1));
+	fill_bitmap(bitmap);
+	char const *const filename = "png_benchmark.png";
+	while (state.KeepRunning()) {
+		util::core_file::ptr file;
+		util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, file);
+		png_write_bitmap(*file, nullptr, bitmap, 0, nullptr);
+	}
+	std::remove(filename);
+	state.SetBytesProcessed(state.iterations() * bitmap.width() * bitmap.height() * 3);
+}
+// Register the function as a benchmark
+BENCHMARK(BM_png_write)->Args({ 320, 240 })->Args({ 1920, 1080 })->Args({ 3840, 2160 });
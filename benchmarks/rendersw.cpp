@@ -0,0 +1,79 @@
+#include "benchmark/benchmark_api.h"
+#include "emu.h"
+#include "rendersw.hxx"
+
+#include <vector>
+
+typedef software_renderer<u32, 0,0,0, 16,8,0> bench_renderer;
+typedef software_renderer<u32, 0,0,0, 16,8,0, false, true> bench_renderer_bilinear;
+
+// a scaled RGB32 screen under full-screen ARGB32 artwork, like a typical
+// game with a bezel
+class render_scene
+{
+public:
+	render_scene(u32 width, u32 height)
+		: m_screen_texels(320 * 240)
+		, m_art_texels(1024 * 768)
+		, m_target(width * height)
+	{
+		for (u32 index = 0; index < m_screen_texels.size(); index++)
+			m_screen_texels[index] = rgb_t(0xff, index * 3, index * 5, index * 7);
+		for (u32 index = 0; index < m_art_texels.size(); index++)
+			m_art_texels[index] = rgb_t(index & 0xff, index >> 4, index >> 8, index >> 12);
+
+		add_quad(0.0f, 0.0f, float(width), float(height), PRIMFLAG_BLENDMODE(BLENDMODE_NONE), nullptr, 0, 0);
+		add_quad(width * 0.125f, height * 0.125f, width * 0.875f, height * 0.875f, PRIMFLAG_TEXFORMAT(TEXFORMAT_RGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_NONE), &m_screen_texels[0], 320, 240);
+		add_quad(0.0f, 0.0f, float(width), float(height), PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA), &m_art_texels[0], 1024, 768);
+	}
+
+	const render_primitive *first() const { return m_list.first(); }
+	u32 *target() { return &m_target[0]; }
+
+private:
+	void add_quad(float x0, float y0, float x1, float y1, u32 flags, u32 *texels, u32 width, u32 height)
+	{
+		render_primitive &prim = m_list.append(*global_alloc(render_primitive));
+		prim.type = render_primitive::QUAD;
+		prim.bounds.x0 = x0;
+		prim.bounds.y0 = y0;
+		prim.bounds.x1 = x1;
+		prim.bounds.y1 = y1;
+		prim.full_bounds = prim.bounds;
+		prim.color.a = prim.color.r = prim.color.g = prim.color.b = 1.0f;
+		prim.flags = flags;
+		memset(&prim.texture, 0, sizeof(prim.texture));
+		prim.texture.base = texels;
+		prim.texture.rowpixels = prim.texture.width = width;
+		prim.texture.height = height;
+		prim.texcoords.tl.u = prim.texcoords.bl.u = prim.texcoords.tl.v = prim.texcoords.tr.v = 0.0f;
+		prim.texcoords.tr.u = prim.texcoords.br.u = prim.texcoords.bl.v = prim.texcoords.br.v = 1.0f;
+	}
+
+	simple_list<render_primitive> m_list;
+	std::vector<u32> m_screen_texels;
+	std::vector<u32> m_art_texels;
+	std::vector<u32> m_target;
+};
+
+template <typename Renderer>
+static void BM_software_renderer(benchmark::State& state) {
+	u32 const width = state.range(0);
+	u32 const height = state.range(1);
+	u32 const bands = state.range(2);
+	render_scene scene(width, height);
+	osd_work_queue *const queue = (bands > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	while (state.KeepRunning()) {
+		Renderer::draw_primitives(scene.first(), scene.target(), width, height, width, queue, bands);
+	}
+	if (queue)
+		osd_work_queue_free(queue);
+	state.SetItemsProcessed(state.iterations() * width * height);
+}
+// Register the function as a benchmark
+BENCHMARK_TEMPLATE(BM_software_renderer, bench_renderer)
+	->Args({ 640, 480, 1 })->Args({ 640, 480, 4 })
+	->Args({ 1920, 1080, 1 })->Args({ 1920, 1080, 4 })->Args({ 1920, 1080, 8 })
+	->Args({ 3840, 2160, 1 })->Args({ 3840, 2160, 4 })->Args({ 3840, 2160, 8 })->Args({ 3840, 2160, 16 });
+BENCHMARK_TEMPLATE(BM_software_renderer, bench_renderer_bilinear)
+	->Args({ 640, 480, 1 })->Args({ 1920, 1080, 1 })->Args({ 3840, 2160, 1 });
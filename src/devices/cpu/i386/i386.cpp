@@ -299,7 +299,7 @@ uint32_t i386_device::get_flags() const
 {
 	uint32_t f = 0x2;
 	f |= m_CF;
-	f |= m_PF << 2;
+	f |= GetPF() << 2;
 	f |= m_AF << 4;
 	f |= m_ZF << 6;
 	f |= m_SF << 7;
@@ -322,7 +322,7 @@ uint32_t i386_device::get_flags() const
 void i386_device::set_flags(uint32_t f )
 {
 	m_CF = (f & 0x1) ? 1 : 0;
-	m_PF = (f & 0x4) ? 1 : 0;
+	SetPFValue(f & 0x4);
 	m_AF = (f & 0x10) ? 1 : 0;
 	m_ZF = (f & 0x40) ? 1 : 0;
 	m_SF = (f & 0x80) ? 1 : 0;
@@ -3282,7 +3282,7 @@ void i386_device::i386_common_init()
 	save_item(NAME(m_SF));
 	save_item(NAME(m_OF));
 	save_item(NAME(m_ZF));
-	save_item(NAME(m_PF));
+	save_item(NAME(m_PF_result));
 	save_item(NAME(m_AF));
 	save_item(NAME(m_IF));
 	save_item(NAME(m_TF));
@@ -3657,7 +3657,7 @@ void i386_device::zero_state()
 	m_SF = 0;
 	m_OF = 0;
 	m_ZF = 0;
-	m_PF = 0;
+	SetPFValue(0);
 	m_AF = 0;
 	m_IF = 0;
 	m_TF = 0;
@@ -3933,6 +3933,8 @@ void i386_device::execute_run()
 		return;
 	}
 
+	const bool check_debugger = ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0);
+
 	while( m_cycles > 0 )
 	{
 		i386_check_irq_line();
@@ -3948,7 +3950,8 @@ void i386_device::execute_run()
 		m_segment_prefix = 0;
 		m_prev_eip = m_eip;
 
-		debugger_instruction_hook(this, m_pc);
+		if (check_debugger)
+			debugger_instruction_hook(this, m_pc);
 
 		if(m_delayed_interrupt_enable != 0)
 		{
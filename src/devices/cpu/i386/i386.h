@@ -159,7 +159,7 @@ struct I386_CALL_GATE
 	uint8_t m_SF;
 	uint8_t m_OF;
 	uint8_t m_ZF;
-	uint8_t m_PF;
+	uint8_t m_PF_result;    // low byte of the last result; PF is its parity
 	uint8_t m_AF;
 	uint8_t m_IF;
 	uint8_t m_TF;
@@ -976,7 +976,7 @@ void i386_device::i386_jno_rel16()         // Opcode 0x0f 81
 void i386_device::i386_jnp_rel16()         // Opcode 0x0f 8b
 {
 	int16_t disp = FETCH16();
-	if( m_PF == 0 ) {
+	if( GetPF() == 0 ) {
 		if (m_sreg[CS].d)
 		{
 			m_eip += disp;
@@ -1052,7 +1052,7 @@ void i386_device::i386_jo_rel16()          // Opcode 0x0f 80
 void i386_device::i386_jp_rel16()          // Opcode 0x0f 8a
 {
 	int16_t disp = FETCH16();
-	if( m_PF != 0 ) {
+	if( GetPF() != 0 ) {
 		if (m_sreg[CS].d)
 		{
 			m_eip += disp;
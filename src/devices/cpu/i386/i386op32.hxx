@@ -881,7 +881,7 @@ void i386_device::i386_jno_rel32()         // Opcode 0x0f 81
 void i386_device::i386_jnp_rel32()         // Opcode 0x0f 8b
 {
 	int32_t disp = FETCH32();
-	if( m_PF == 0 ) {
+	if( GetPF() == 0 ) {
 		m_eip += disp;
 		CHANGE_PC(m_eip);
 		CYCLES(CYCLES_JCC_FULL_DISP);      /* TODO: Timing = 7 + m */
@@ -929,7 +929,7 @@ void i386_device::i386_jo_rel32()          // Opcode 0x0f 80
 void i386_device::i386_jp_rel32()          // Opcode 0x0f 8a
 {
 	int32_t disp = FETCH32();
-	if( m_PF != 0 ) {
+	if( GetPF() != 0 ) {
 		m_eip += disp;
 		CHANGE_PC(m_eip);
 		CYCLES(CYCLES_JCC_FULL_DISP);      /* TODO: Timing = 7 + m */
@@ -504,7 +504,7 @@ void i386_device::i386_jno_rel8()          // Opcode 0x71
 void i386_device::i386_jnp_rel8()          // Opcode 0x7b
 {
 	int8_t disp = FETCH();
-	if( m_PF == 0 ) {
+	if( GetPF() == 0 ) {
 		NEAR_BRANCH(disp);
 		CYCLES(CYCLES_JCC_DISP8);      /* TODO: Timing = 7 + m */
 	} else {
@@ -548,7 +548,7 @@ void i386_device::i386_jo_rel8()           // Opcode 0x70
 void i386_device::i386_jp_rel8()           // Opcode 0x7a
 {
 	int8_t disp = FETCH();
-	if( m_PF != 0 ) {
+	if( GetPF() != 0 ) {
 		NEAR_BRANCH(disp);
 		CYCLES(CYCLES_JCC_DISP8);      /* TODO: Timing = 7 + m */
 	} else {
@@ -1521,7 +1521,7 @@ void i386_device::i386_setnp_rm8()         // Opcode 0x0f 9b
 {
 	uint8_t modrm = FETCH();
 	uint8_t value = 0;
-	if( m_PF == 0 ) {
+	if( GetPF() == 0 ) {
 		value = 1;
 	}
 	if( modrm >= 0xc0 ) {
@@ -1589,7 +1589,7 @@ void i386_device::i386_setp_rm8()          // Opcode 0x0f 9a
 {
 	uint8_t modrm = FETCH();
 	uint8_t value = 0;
-	if( m_PF != 0 ) {
+	if( GetPF() != 0 ) {
 		value = 1;
 	}
 	if( modrm >= 0xc0 ) {
@@ -314,11 +314,15 @@ extern int i386_parity_table[256];
 #define SetSF(x)            (m_SF = (x))
 #define SetZF(x)            (m_ZF = (x))
 #define SetAF(x,y,z)        (m_AF = (((x) ^ ((y) ^ (z))) & 0x10) ? 1 : 0)
-#define SetPF(x)            (m_PF = i386_parity_table[(x) & 0xFF])
-
-#define SetSZPF8(x)         {m_ZF = ((uint8_t)(x)==0);  m_SF = ((x)&0x80) ? 1 : 0; m_PF = i386_parity_table[x & 0xFF]; }
-#define SetSZPF16(x)        {m_ZF = ((uint16_t)(x)==0);  m_SF = ((x)&0x8000) ? 1 : 0; m_PF = i386_parity_table[x & 0xFF]; }
-#define SetSZPF32(x)        {m_ZF = ((uint32_t)(x)==0);  m_SF = ((x)&0x80000000) ? 1 : 0; m_PF = i386_parity_table[x & 0xFF]; }
+/* PF is evaluated lazily: arithmetic only stores the low byte of its result,
+   and the parity is looked up when something actually reads the flag */
+#define SetPF(x)            (m_PF_result = (uint8_t)(x))
+#define SetPFValue(x)       (m_PF_result = (x) ? 0 : 1)
+#define GetPF()             (i386_parity_table[m_PF_result])
+
+#define SetSZPF8(x)         {m_ZF = ((uint8_t)(x)==0);  m_SF = ((x)&0x80) ? 1 : 0; m_PF_result = (uint8_t)(x); }
+#define SetSZPF16(x)        {m_ZF = ((uint16_t)(x)==0);  m_SF = ((x)&0x8000) ? 1 : 0; m_PF_result = (uint8_t)(x); }
+#define SetSZPF32(x)        {m_ZF = ((uint32_t)(x)==0);  m_SF = ((x)&0x80000000) ? 1 : 0; m_PF_result = (uint8_t)(x); }
 
 #define MMX(n)              (*((MMX_REG *)(&m_x87_reg[(n)].low)))
 #define XMM(n)              m_sse_reg[(n)]
@@ -729,7 +729,7 @@ void i386_device::pentium_cmovp_r16_rm16()    // Opcode 0x0f 4a
 
 	if( modrm >= 0xc0 )
 	{
-		if (m_PF == 1)
+		if (GetPF() == 1)
 		{
 			src = LOAD_RM16(modrm);
 			STORE_REG16(modrm, src);
@@ -739,7 +739,7 @@ void i386_device::pentium_cmovp_r16_rm16()    // Opcode 0x0f 4a
 	else
 	{
 		uint32_t ea = GetEA(modrm,0);
-		if (m_PF == 1)
+		if (GetPF() == 1)
 		{
 			src = READ16(ea);
 			STORE_REG16(modrm, src);
@@ -755,7 +755,7 @@ void i386_device::pentium_cmovp_r32_rm32()    // Opcode 0x0f 4a
 
 	if( modrm >= 0xc0 )
 	{
-		if (m_PF == 1)
+		if (GetPF() == 1)
 		{
 			src = LOAD_RM32(modrm);
 			STORE_REG32(modrm, src);
@@ -765,7 +765,7 @@ void i386_device::pentium_cmovp_r32_rm32()    // Opcode 0x0f 4a
 	else
 	{
 		uint32_t ea = GetEA(modrm,0);
-		if (m_PF == 1)
+		if (GetPF() == 1)
 		{
 			src = READ32(ea);
 			STORE_REG32(modrm, src);
@@ -781,7 +781,7 @@ void i386_device::pentium_cmovnp_r16_rm16()    // Opcode 0x0f 4b
 
 	if( modrm >= 0xc0 )
 	{
-		if (m_PF == 0)
+		if (GetPF() == 0)
 		{
 			src = LOAD_RM16(modrm);
 			STORE_REG16(modrm, src);
@@ -791,7 +791,7 @@ void i386_device::pentium_cmovnp_r16_rm16()    // Opcode 0x0f 4b
 	else
 	{
 		uint32_t ea = GetEA(modrm,0);
-		if (m_PF == 0)
+		if (GetPF() == 0)
 		{
 			src = READ16(ea);
 			STORE_REG16(modrm, src);
@@ -807,7 +807,7 @@ void i386_device::pentium_cmovnp_r32_rm32()    // Opcode 0x0f 4b
 
 	if( modrm >= 0xc0 )
 	{
-		if (m_PF == 0)
+		if (GetPF() == 0)
 		{
 			src = LOAD_RM32(modrm);
 			STORE_REG32(modrm, src);
@@ -817,7 +817,7 @@ void i386_device::pentium_cmovnp_r32_rm32()    // Opcode 0x0f 4b
 	else
 	{
 		uint32_t ea = GetEA(modrm,0);
-		if (m_PF == 0)
+		if (GetPF() == 0)
 		{
 			src = READ32(ea);
 			STORE_REG32(modrm, src);
@@ -4044,13 +4044,13 @@ void i386_device::sse_comiss_r128_r128m32() // Opcode 0f 2f
 	if (float32_is_nan(a) || float32_is_nan(b))
 	{
 		m_ZF = 1;
-		m_PF = 1;
+		SetPFValue(1);
 		m_CF = 1;
 	}
 	else
 	{
 		m_ZF = 0;
-		m_PF = 0;
+		SetPFValue(0);
 		m_CF = 0;
 		if (float32_eq(a, b))
 			m_ZF = 1;
@@ -4081,13 +4081,13 @@ void i386_device::sse_comisd_r128_r128m64() // Opcode 66 0f 2f
 	if (float64_is_nan(a) || float64_is_nan(b))
 	{
 		m_ZF = 1;
-		m_PF = 1;
+		SetPFValue(1);
 		m_CF = 1;
 	}
 	else
 	{
 		m_ZF = 0;
-		m_PF = 0;
+		SetPFValue(0);
 		m_CF = 0;
 		if (float64_eq(a, b))
 			m_ZF = 1;
@@ -4118,13 +4118,13 @@ void i386_device::sse_ucomiss_r128_r128m32() // Opcode 0f 2e
 	if (float32_is_nan(a) || float32_is_nan(b))
 	{
 		m_ZF = 1;
-		m_PF = 1;
+		SetPFValue(1);
 		m_CF = 1;
 	}
 	else
 	{
 		m_ZF = 0;
-		m_PF = 0;
+		SetPFValue(0);
 		m_CF = 0;
 		if (float32_eq(a, b))
 			m_ZF = 1;
@@ -4155,13 +4155,13 @@ void i386_device::sse_ucomisd_r128_r128m64() // Opcode 66 0f 2e
 	if (float64_is_nan(a) || float64_is_nan(b))
 	{
 		m_ZF = 1;
-		m_PF = 1;
+		SetPFValue(1);
 		m_CF = 1;
 	}
 	else
 	{
 		m_ZF = 0;
-		m_PF = 0;
+		SetPFValue(0);
 		m_CF = 0;
 		if (float64_eq(a, b))
 			m_ZF = 1;
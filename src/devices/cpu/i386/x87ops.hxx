@@ -2053,7 +2053,7 @@ void i386_device::x87_fcmovu_sti(uint8_t modrm)
 	floatx80 result;
 	int i = modrm & 7;
 
-	if (m_PF == 1)
+	if (GetPF() == 1)
 	{
 		if (X87_IS_ST_EMPTY(i))
 		{
@@ -2149,7 +2149,7 @@ void i386_device::x87_fcmovnu_sti(uint8_t modrm)
 	floatx80 result;
 	int i = modrm & 7;
 
-	if (m_PF == 0)
+	if (GetPF() == 0)
 	{
 		if (X87_IS_ST_EMPTY(i))
 		{
@@ -4010,7 +4010,7 @@ void i386_device::x87_fcomi_sti(uint8_t modrm)
 	{
 		x87_set_stack_underflow();
 		m_ZF = 1;
-		m_PF = 1;
+		SetPFValue(1);
 		m_CF = 1;
 	}
 	else
@@ -4023,14 +4023,14 @@ void i386_device::x87_fcomi_sti(uint8_t modrm)
 		if (floatx80_is_nan(a) || floatx80_is_nan(b))
 		{
 			m_ZF = 1;
-			m_PF = 1;
+			SetPFValue(1);
 			m_CF = 1;
 			m_x87_sw |= X87_SW_IE;
 		}
 		else
 		{
 			m_ZF = 0;
-			m_PF = 0;
+			SetPFValue(0);
 			m_CF = 0;
 
 			if (floatx80_eq(a, b))
@@ -4054,7 +4054,7 @@ void i386_device::x87_fcomip_sti(uint8_t modrm)
 	{
 		x87_set_stack_underflow();
 		m_ZF = 1;
-		m_PF = 1;
+		SetPFValue(1);
 		m_CF = 1;
 	}
 	else
@@ -4067,14 +4067,14 @@ void i386_device::x87_fcomip_sti(uint8_t modrm)
 		if (floatx80_is_nan(a) || floatx80_is_nan(b))
 		{
 			m_ZF = 1;
-			m_PF = 1;
+			SetPFValue(1);
 			m_CF = 1;
 			m_x87_sw |= X87_SW_IE;
 		}
 		else
 		{
 			m_ZF = 0;
-			m_PF = 0;
+			SetPFValue(0);
 			m_CF = 0;
 
 			if (floatx80_eq(a, b))
@@ -4099,7 +4099,7 @@ void i386_device::x87_fucomi_sti(uint8_t modrm)
 	{
 		x87_set_stack_underflow();
 		m_ZF = 1;
-		m_PF = 1;
+		SetPFValue(1);
 		m_CF = 1;
 	}
 	else
@@ -4112,20 +4112,20 @@ void i386_device::x87_fucomi_sti(uint8_t modrm)
 		if (floatx80_is_quiet_nan(a) || floatx80_is_quiet_nan(b))
 		{
 			m_ZF = 1;
-			m_PF = 1;
+			SetPFValue(1);
 			m_CF = 1;
 		}
 		else if (floatx80_is_nan(a) || floatx80_is_nan(b))
 		{
 			m_ZF = 1;
-			m_PF = 1;
+			SetPFValue(1);
 			m_CF = 1;
 			m_x87_sw |= X87_SW_IE;
 		}
 		else
 		{
 			m_ZF = 0;
-			m_PF = 0;
+			SetPFValue(0);
 			m_CF = 0;
 
 			if (floatx80_eq(a, b))
@@ -4149,7 +4149,7 @@ void i386_device::x87_fucomip_sti(uint8_t modrm)
 	{
 		x87_set_stack_underflow();
 		m_ZF = 1;
-		m_PF = 1;
+		SetPFValue(1);
 		m_CF = 1;
 	}
 	else
@@ -4162,20 +4162,20 @@ void i386_device::x87_fucomip_sti(uint8_t modrm)
 		if (floatx80_is_quiet_nan(a) || floatx80_is_quiet_nan(b))
 		{
 			m_ZF = 1;
-			m_PF = 1;
+			SetPFValue(1);
 			m_CF = 1;
 		}
 		else if (floatx80_is_nan(a) || floatx80_is_nan(b))
 		{
 			m_ZF = 1;
-			m_PF = 1;
+			SetPFValue(1);
 			m_CF = 1;
 			m_x87_sw |= X87_SW_IE;
 		}
 		else
 		{
 			m_ZF = 0;
-			m_PF = 0;
+			SetPFValue(0);
 			m_CF = 0;
 
 			if (floatx80_eq(a, b))
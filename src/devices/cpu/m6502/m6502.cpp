@@ -381,11 +381,12 @@ void m6502_device::execute_run()
 	if(inst_substate)
 		do_exec_partial();
 
+	const bool check_debugger = machine().debug_flags & DEBUG_FLAG_ENABLED;
 	while(icount > 0) {
 		if(inst_state < 0xff00) {
 			PPC = NPC;
 			inst_state = IR | inst_state_base;
-			if(machine().debug_flags & DEBUG_FLAG_ENABLED)
+			if(check_debugger)
 				debugger_instruction_hook(this, NPC);
 		}
 		do_exec_full();
@@ -631,11 +632,13 @@ offs_t m6502_device::disassemble_generic(std::ostream &stream, offs_t pc, const
 void m6502_device::prefetch()
 {
 	sync = true;
-	sync_w(ASSERT_LINE);
+	if(!sync_w.isnull())
+		sync_w(ASSERT_LINE);
 	NPC = PC;
 	IR = mintf->read_sync(PC);
 	sync = false;
-	sync_w(CLEAR_LINE);
+	if(!sync_w.isnull())
+		sync_w(CLEAR_LINE);
 
 	if((nmi_state || ((irq_state || apu_irq_state) && !(P & F_I))) && !inhibit_interrupts) {
 		irq_taken = true;
@@ -647,11 +650,13 @@ void m6502_device::prefetch()
 void m6502_device::prefetch_noirq()
 {
 	sync = true;
-	sync_w(ASSERT_LINE);
+	if(!sync_w.isnull())
+		sync_w(ASSERT_LINE);
 	NPC = PC;
 	IR = mintf->read_sync(PC);
 	sync = false;
-	sync_w(CLEAR_LINE);
+	if(!sync_w.isnull())
+		sync_w(CLEAR_LINE);
 	PC++;
 }
 
@@ -278,6 +278,7 @@ public:
 		void init32hmmu(address_space &space, address_space &ospace);
 
 		offs_t  opcode_xor;                     // Address Calculation
+		bool    direct_fetch;                   // Immediate reads can go straight to m_odirect
 		m68k_readimm16_delegate readimm16;      // Immediate read 16 bit
 		m68k_read8_delegate read8;
 		m68k_read16_delegate read16;
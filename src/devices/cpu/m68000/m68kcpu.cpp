@@ -791,6 +791,10 @@ inline void m68000_base_device::cpu_execute(void)
 		}
 
 
+		/* Only pay for the per-instruction hooks when someone is listening */
+		const bool check_debugger = ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0);
+		const bool check_hook = !instruction_hook.isnull();
+
 		/* Main loop.  Keep going until we run out of clock cycles */
 		while (remaining_cycles > 0)
 		{
@@ -801,10 +805,11 @@ inline void m68000_base_device::cpu_execute(void)
 			REG_PPC(this) = REG_PC(this);
 
 			/* Call external hook to peek at CPU */
-			debugger_instruction_hook(this, REG_PC(this));
+			if (check_debugger)
+				debugger_instruction_hook(this, REG_PC(this));
 
 			/* call external instruction hook (independent of debug mode) */
-			if (!instruction_hook.isnull())
+			if (check_hook)
 				instruction_hook(*program, REG_PC(this), 0xffffffff);
 
 			try
@@ -1241,6 +1246,7 @@ void m68000_base_device::init8(address_space &space, address_space &ospace)
 //  m_cpustate = this;
 	opcode_xor = 0;
 
+	direct_fetch = false;
 	readimm16 = m68k_readimm16_delegate(&m68000_base_device::m68008_read_immediate_16, this);
 	read8 = m68k_read8_delegate(&address_space::read_byte, &space);
 	read16 = m68k_read16_delegate(&address_space::read_word, &space);
@@ -1280,6 +1286,7 @@ void m68000_base_device::init16(address_space &space, address_space &ospace)
 
 	opcode_xor = 0;
 
+	direct_fetch = true;
 	readimm16 = m68k_readimm16_delegate(&m68000_base_device::simple_read_immediate_16, this);
 	read8 = m68k_read8_delegate(&address_space::read_byte, &space);
 	read16 = m68k_read16_delegate(&address_space::read_word, &space);
@@ -1306,6 +1313,7 @@ void m68000_base_device::init32(address_space &space, address_space &ospace)
 	m_odirect = &ospace.direct();
 	opcode_xor = WORD_XOR_BE(0);
 
+	direct_fetch = true;
 	readimm16 = m68k_readimm16_delegate(&m68000_base_device::read_immediate_16, this);
 	read8 = m68k_read8_delegate(&address_space::read_byte, &space);
 	read16 = m68k_read16_delegate(&address_space::read_word_unaligned, &space);
@@ -1525,6 +1533,7 @@ void m68000_base_device::init32mmu(address_space &space, address_space &ospace)
 	m_odirect = &ospace.direct();
 	opcode_xor = WORD_XOR_BE(0);
 
+	direct_fetch = false;
 	readimm16 = m68k_readimm16_delegate(&m68000_base_device::read_immediate_16_mmu, this);
 	read8 = m68k_read8_delegate(&m68000_base_device::read_byte_32_mmu, this);
 	read16 = m68k_read16_delegate(&m68000_base_device::readword_d32_mmu, this);
@@ -1653,6 +1662,7 @@ void m68000_base_device::init32hmmu(address_space &space, address_space &ospace)
 	m_odirect = &ospace.direct();
 	opcode_xor = WORD_XOR_BE(0);
 
+	direct_fetch = false;
 	readimm16 = m68k_readimm16_delegate(&m68000_base_device::read_immediate_16_hmmu, this);
 	read8 = m68k_read8_delegate(&m68000_base_device::read_byte_32_hmmu, this);
 	read16 = m68k_read16_delegate(&m68000_base_device::readword_d32_hmmu, this);
@@ -2383,6 +2393,7 @@ void m68000_base_device::clear_all()
 	program = nullptr;
 
 	opcode_xor = 0;
+	direct_fetch = false;
 //  readimm16 = 0;
 //  read8 = 0;
 //  read16 = 0;
@@ -725,6 +725,11 @@ static inline uint32_t m68ki_ic_readimm16(m68000_base_device *m68k, uint32_t add
 		}
 	}
 
+	// plain 16/32-bit buses fetch straight from the opcode direct region,
+	// sparing a delegate call for every prefetch
+	if (m68k->direct_fetch)
+		return m68k->m_odirect->read_word(address, m68k->opcode_xor);
+
 	return m68k->readimm16(address);
 }
 
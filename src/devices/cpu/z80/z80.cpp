@@ -474,9 +474,12 @@ inline uint8_t z80_device::rop()
 	unsigned pc = PCD;
 	PC++;
 	uint8_t res = m_decrypted_opcodes_direct->read_byte(pc);
-	m_icount -= 2;
-	m_refresh_cb((m_i << 8) | (m_r2 & 0x80) | ((m_r-1) & 0x7f));
-	m_icount += 2;
+	if (!m_refresh_cb.isnull())
+	{
+		m_icount -= 2;
+		m_refresh_cb((m_i << 8) | (m_r2 & 0x80) | ((m_r-1) & 0x7f));
+		m_icount += 2;
+	}
 	return res;
 }
 
@@ -3495,6 +3498,8 @@ void nsc800_device::device_reset()
  ****************************************************************************/
 void z80_device::execute_run()
 {
+	const bool check_debugger = ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0);
+
 	do
 	{
 		if (m_wait_state)
@@ -3514,7 +3519,8 @@ void z80_device::execute_run()
 		m_after_ldair = false;
 
 		PRVPC = PCD;
-		debugger_instruction_hook(this, PCD);
+		if (check_debugger)
+			debugger_instruction_hook(this, PCD);
 		m_r++;
 		EXEC(op,rop());
 	} while (m_icount > 0);
@@ -3522,6 +3528,8 @@ void z80_device::execute_run()
 
 void nsc800_device::execute_run()
 {
+	const bool check_debugger = ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0);
+
 	do
 	{
 		if (m_wait_state)
@@ -3543,7 +3551,8 @@ void nsc800_device::execute_run()
 		m_after_ldair = false;
 
 		PRVPC = PCD;
-		debugger_instruction_hook(this, PCD);
+		if (check_debugger)
+			debugger_instruction_hook(this, PCD);
 		m_r++;
 		EXEC(op,rop());
 	} while (m_icount > 0);
@@ -165,6 +165,7 @@ void m68307cpu_device::init16_m68307(address_space &space)
 	m_space = &space;
 	m_direct = &space.direct();
 	opcode_xor = 0;
+	direct_fetch = false;
 
 	readimm16 = m68k_readimm16_delegate(&m68307cpu_device::simple_read_immediate_16_m68307, this);
 	read8 = m68k_read8_delegate(&m68307cpu_device::read_byte_m68307, this);
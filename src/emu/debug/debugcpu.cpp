@@ -22,6 +22,7 @@
 
 #include "coreutil.h"
 #include "osdepend.h"
+#include "tracefile.h"
 #include "xmlfile.h"
 
 #include <ctype.h>
@@ -1873,6 +1874,10 @@ void device_debug::instruction_hook(offs_t curpc)
 
 void device_debug::memory_read_hook(address_space &space, offs_t address, u64 mem_mask)
 {
+	// record the access if tracing memory
+	if (m_trace != nullptr && m_trace->memory())
+		m_trace->memory_read(space, address, mem_mask);
+
 	// check watchpoints
 	watchpoint_check(space, WATCHPOINT_READ, address, 0, mem_mask);
 
@@ -1890,6 +1895,8 @@ void device_debug::memory_read_hook(address_space &space, offs_t address, u64 me
 
 void device_debug::memory_write_hook(address_space &space, offs_t address, u64 data, u64 mem_mask)
 {
+	if (m_trace != nullptr && m_trace->memory())
+		m_trace->memory_write(space, address, data, mem_mask);
 	if (m_track_mem)
 	{
 		dasm_memory_access const newAccess(space.spacenum(), address, data, history_pc(0));
@@ -2423,6 +2430,22 @@ void device_debug::set_track_pc_visited(const offs_t& pc)
 }
 
 
+//-------------------------------------------------
+//  set_track_mem - enable or disable memory
+//  tracking; writes only reach the hook through
+//  the watchpoint handlers, so refresh those
+//-------------------------------------------------
+
+void device_debug::set_track_mem(bool value)
+{
+	m_track_mem = value;
+	if (m_memory != nullptr)
+		for (address_spacenum spacenum = AS_0; spacenum < ARRAY_LENGTH(m_wplist); ++spacenum)
+			if (m_memory->has_space(spacenum))
+				watchpoint_update_flags(m_memory->space(spacenum));
+}
+
+
 //-------------------------------------------------
 //  track_mem_pc_from_address_data - returns the pc that
 //  wrote the data to this address or (offs_t)(-1) for
@@ -2581,14 +2604,21 @@ u32 device_debug::compute_opcode_crc32(offs_t pc) const
 //  trace - trace execution of a given device
 //-------------------------------------------------
 
-void device_debug::trace(FILE *file, bool trace_over, bool detect_loops, bool logerror, const char *action)
+void device_debug::trace(FILE *file, bool trace_over, bool detect_loops, bool logerror, bool binary, bool memory, const char *action)
 {
 	// delete any existing tracers
+	bool const was_memory = m_trace != nullptr && m_trace->memory();
 	m_trace = nullptr;
 
 	// if we have a new file, make a new tracer
 	if (file != nullptr)
-		m_trace = std::make_unique<tracer>(*this, *file, trace_over, detect_loops, logerror, action);
+		m_trace = std::make_unique<tracer>(*this, *file, trace_over, detect_loops, logerror, binary, memory, action);
+
+	// memory tracing needs the watchpoint handlers on every space
+	if ((was_memory || (m_trace != nullptr && m_trace->memory())) && m_memory != nullptr)
+		for (address_spacenum spacenum = AS_0; spacenum < ARRAY_LENGTH(m_wplist); ++spacenum)
+			if (m_memory->has_space(spacenum))
+				watchpoint_update_flags(m_memory->space(spacenum));
 }
 
 
@@ -2777,18 +2807,32 @@ void device_debug::watchpoint_update_flags(address_space &space)
 	if (!m_hotspots.empty())
 		enableread = true;
 
-	// see if there are any enabled breakpoints
+	// memory tracing needs everything
 	bool enablewrite = false;
+	if (m_trace != nullptr && m_trace->memory())
+		enableread = enablewrite = true;
+
+	// memory tracking records every write
+	if (m_track_mem)
+		enablewrite = true;
+
+	// gather the ranges covered by enabled watchpoints; only those pages
+	// need to go through the watchpoint handlers
+	std::vector<std::pair<offs_t, offs_t>> readranges, writeranges;
 	for (watchpoint *wp = m_wplist[space.spacenum()]; wp != nullptr; wp = wp->m_next)
-		if (wp->m_enabled)
+		if (wp->m_enabled && wp->m_length != 0)
 		{
+			offs_t const start = wp->m_address;
+			offs_t const end = (start + wp->m_length - 1 < start) ? ~offs_t(0) : (start + wp->m_length - 1);
 			if (wp->m_type & WATCHPOINT_READ)
-				enableread = true;
+				readranges.emplace_back(start, end);
 			if (wp->m_type & WATCHPOINT_WRITE)
-				enablewrite = true;
+				writeranges.emplace_back(start, end);
 		}
 
-	// push the flags out globally
+	// push the ranges and flags out to the space
+	space.set_read_watchpoint_ranges(std::move(readranges));
+	space.set_write_watchpoint_ranges(std::move(writeranges));
 	space.enable_read_watchpoints(enableread);
 	space.enable_write_watchpoints(enablewrite);
 }
@@ -3249,7 +3293,7 @@ bool device_debug::registerpoint::hit()
 //  tracer - constructor
 //-------------------------------------------------
 
-device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, bool detect_loops, bool logerror, const char *action)
+device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, bool detect_loops, bool logerror, bool binary, bool memory, const char *action)
 	: m_debug(debug)
 	, m_file(file)
 	, m_action((action != nullptr) ? action : "")
@@ -3259,8 +3303,31 @@ device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, b
 	, m_nextdex(0)
 	, m_trace_over(trace_over)
 	, m_trace_over_target(~0)
+	, m_memory(binary && memory)
+	, m_opcode_bytes(0)
 {
 	memset(m_history, 0, sizeof(m_history));
+
+	if (binary)
+	{
+		// describe the device, then record where every register starts
+		device_memory_interface *const memintf = m_debug.m_memory;
+		bool const decrypted = memintf != nullptr && memintf->has_space(AS_DECRYPTED_OPCODES);
+		m_writer = std::make_unique<util::trace_writer>(m_file);
+		m_writer->device(decrypted ? util::TRACE_FLAG_ARGUMENTS : 0, m_debug.m_device.shortname(), m_debug.m_device.tag());
+		if (memintf != nullptr && memintf->has_space(AS_PROGRAM))
+			m_opcode_bytes = std::min<int>((m_debug.m_disasm != nullptr) ? m_debug.m_disasm->max_opcode_bytes() : 1, 64);
+
+		if (m_debug.m_state != nullptr)
+			for (const auto &entry : m_debug.m_state->state_entries())
+				if (entry->visible() && !entry->divider())
+				{
+					u64 const value = m_debug.m_state->state_int(entry->index());
+					m_writer->register_name(m_registers.size(), entry->symbol());
+					m_writer->register_value(m_registers.size(), value);
+					m_registers.emplace_back(entry->index(), value);
+				}
+	}
 }
 
 
@@ -3270,7 +3337,9 @@ device_debug::tracer::tracer(device_debug &debug, FILE &file, bool trace_over, b
 
 device_debug::tracer::~tracer()
 {
-	// make sure we close the file if we can
+	// write out anything still pending, then close the file
+	flush();
+	m_writer = nullptr;
 	fclose(&m_file);
 }
 
@@ -3290,7 +3359,8 @@ void device_debug::tracer::update(offs_t pc)
 		m_trace_over_target = ~0;
 	}
 
-	if (m_detect_loops)
+	// binary traces are compressed, so they keep every iteration of a loop
+	if (m_detect_loops && m_writer == nullptr)
 	{
 		// check for a loop condition
 		int count = 0;
@@ -3315,18 +3385,29 @@ void device_debug::tracer::update(offs_t pc)
 	if (!m_action.empty())
 		m_debug.m_device.machine().debugger().console().execute_command(m_action.c_str(), false);
 
-	// print the address
-	std::string buffer;
-	int logaddrchars = m_debug.logaddrchars();
-	buffer = string_format("%0*X: ", logaddrchars, pc);
-
-	// print the disassembly
 	std::string dasm;
-	offs_t dasmresult = m_debug.dasm_wrapped(dasm, pc);
-	buffer.append(dasm);
+	offs_t dasmresult = 0;
+	if (m_writer != nullptr)
+	{
+		// record the raw instruction; only tracing over needs it disassembled
+		record_instruction(pc);
+		if (m_trace_over)
+			dasmresult = m_debug.dasm_wrapped(dasm, pc);
+	}
+	else
+	{
+		// print the address
+		std::string buffer;
+		int logaddrchars = m_debug.logaddrchars();
+		buffer = string_format("%0*X: ", logaddrchars, pc);
+
+		// print the disassembly
+		dasmresult = m_debug.dasm_wrapped(dasm, pc);
+		buffer.append(dasm);
 
-	// output the result
-	fprintf(&m_file, "%s\n", buffer.c_str());
+		// output the result
+		fprintf(&m_file, "%s\n", buffer.c_str());
+	}
 
 	// do we need to step the trace over this instruction?
 	if (m_trace_over && (dasmresult & DASMFLAG_SUPPORTED) != 0 && (dasmresult & DASMFLAG_STEP_OVER) != 0)
@@ -3344,7 +3425,87 @@ void device_debug::tracer::update(offs_t pc)
 	// log this PC
 	m_nextdex = (m_nextdex + 1) % TRACE_LOOPS;
 	m_history[m_nextdex] = pc;
-	fflush(&m_file);
+	if (m_writer == nullptr)
+		fflush(&m_file);
+}
+
+
+//-------------------------------------------------
+//  record_instruction - add an instruction to a
+//  binary trace, along with the registers the
+//  previous one changed and any opcode bytes
+//  that haven't been seen at this PC
+//-------------------------------------------------
+
+void device_debug::tracer::record_instruction(offs_t pc)
+{
+	// registers changed since the last instruction
+	for (std::size_t slot = 0; slot < m_registers.size(); slot++)
+	{
+		u64 const value = m_debug.m_state->state_int(m_registers[slot].first);
+		if (value != m_registers[slot].second)
+		{
+			m_registers[slot].second = value;
+			m_writer->register_value(slot, value);
+		}
+	}
+
+	// opcode bytes, only when they differ from what was last recorded here
+	if (m_opcode_bytes != 0)
+	{
+		debugger_cpu &debugcpu = m_debug.m_device.machine().debugger().cpu();
+		address_space &space = m_debug.m_memory->space(AS_PROGRAM);
+		bool const decrypted = m_debug.m_memory->has_space(AS_DECRYPTED_OPCODES);
+		address_space &opspace = decrypted ? m_debug.m_memory->space(AS_DECRYPTED_OPCODES) : space;
+		offs_t const pcbyte = space.address_to_byte(pc) & space.bytemask();
+
+		u8 opbuf[64], argbuf[64];
+		for (int numbytes = 0; numbytes < m_opcode_bytes; numbytes++)
+		{
+			opbuf[numbytes] = debugcpu.read_opcode(opspace, pcbyte + numbytes, 1);
+			if (decrypted)
+				argbuf[numbytes] = debugcpu.read_opcode(space, pcbyte + numbytes, 1);
+		}
+
+		u32 crc = core_crc32(0, opbuf, m_opcode_bytes);
+		if (decrypted)
+			crc = core_crc32(crc, argbuf, m_opcode_bytes);
+		auto const found = m_opcodes.emplace(pc, crc);
+		if (found.second || found.first->second != crc)
+		{
+			found.first->second = crc;
+			m_writer->opcode(pc, opbuf, decrypted ? argbuf : nullptr, m_opcode_bytes);
+		}
+	}
+
+	m_writer->instruction(pc);
+}
+
+
+//-------------------------------------------------
+//  memory_read - record a memory read made by
+//  the traced device
+//-------------------------------------------------
+
+void device_debug::tracer::memory_read(address_space &space, offs_t address, u64 mem_mask)
+{
+	// ignore the debugger's own accesses
+	if (space.machine().debugger().cpu().within_instruction_hook() || space.machine().side_effect_disabled())
+		return;
+	m_writer->memory_read(space.spacenum(), address, mem_mask);
+}
+
+
+//-------------------------------------------------
+//  memory_write - record a memory write made by
+//  the traced device
+//-------------------------------------------------
+
+void device_debug::tracer::memory_write(address_space &space, offs_t address, u64 data, u64 mem_mask)
+{
+	if (space.machine().debugger().cpu().within_instruction_hook() || space.machine().side_effect_disabled())
+		return;
+	m_writer->memory_write(space.spacenum(), address, data, mem_mask);
 }
 
 
@@ -3354,6 +3515,15 @@ void device_debug::tracer::update(offs_t pc)
 
 void device_debug::tracer::vprintf(const char *format, va_list va)
 {
+	// binary traces keep text as records
+	if (m_writer != nullptr)
+	{
+		std::string text;
+		strcatvprintf(text, format, va);
+		m_writer->text(text.c_str(), text.length());
+		return;
+	}
+
 	// pass through to the file
 	vfprintf(&m_file, format, va);
 	fflush(&m_file);
@@ -3367,7 +3537,16 @@ void device_debug::tracer::vprintf(const char *format, va_list va)
 
 void device_debug::tracer::flush()
 {
-	fflush(&m_file);
+	if (m_writer != nullptr)
+	{
+		// report a failed write once; the writer stops at the first one
+		bool const failed = !m_writer->error().empty();
+		m_writer->flush();
+		if (!failed && !m_writer->error().empty())
+			osd_printf_error("Error tracing '%s': %s\n", m_debug.m_device.tag(), m_writer->error().c_str());
+	}
+	else
+		fflush(&m_file);
 }
 
 
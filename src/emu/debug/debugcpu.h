@@ -16,9 +16,11 @@
 #include "express.h"
 
 #include <set>
+#include <unordered_map>
 
 
 namespace util { namespace xml { class data_node; } }
+namespace util { class trace_writer; }
 
 
 //**************************************************************************
@@ -256,14 +258,14 @@ public:
 	void track_pc_data_clear() { m_track_pc_set.clear(); }
 
 	// memory tracking
-	void set_track_mem(bool value) { m_track_mem = value; }
+	void set_track_mem(bool value);
 	offs_t track_mem_pc_from_space_address_data(const address_spacenum& space,
 												const offs_t& address,
 												const u64& data) const;
 	void track_mem_data_clear() { m_track_mem_set.clear(); }
 
 	// tracing
-	void trace(FILE *file, bool trace_over, bool detect_loops, bool logerror, const char *action);
+	void trace(FILE *file, bool trace_over, bool detect_loops, bool logerror, bool binary, bool memory, const char *action);
 	void trace_printf(const char *fmt, ...) ATTR_PRINTF(2,3);
 	void trace_flush() { if (m_trace != nullptr) m_trace->flush(); }
 
@@ -337,17 +339,22 @@ private:
 	class tracer
 	{
 	public:
-		tracer(device_debug &debug, FILE &file, bool trace_over, bool detect_loops, bool logerror, const char *action);
+		tracer(device_debug &debug, FILE &file, bool trace_over, bool detect_loops, bool logerror, bool binary, bool memory, const char *action);
 		~tracer();
 
 		void update(offs_t pc);
 		void vprintf(const char *format, va_list va);
 		void flush();
 		bool logerror() const { return m_logerror; }
+		bool memory() const { return m_memory; }
+		void memory_read(address_space &space, offs_t address, u64 mem_mask);
+		void memory_write(address_space &space, offs_t address, u64 data, u64 mem_mask);
 
 	private:
 		static const int TRACE_LOOPS = 64;
 
+		void record_instruction(offs_t pc);
+
 		device_debug &      m_debug;                    // reference to our owner
 		FILE &              m_file;                     // tracing file for this CPU
 		std::string         m_action;                   // action to perform during a trace
@@ -360,6 +367,13 @@ private:
 		offs_t              m_trace_over_target;        // target for tracing over
 														//    (0 = not tracing over,
 														//    ~0 = not currently tracing over)
+
+		// binary tracing
+		std::unique_ptr<util::trace_writer> m_writer;   // binary trace writer, or nullptr for text
+		bool                m_memory;                   // whether or not we record memory accesses
+		int                 m_opcode_bytes;             // opcode bytes recorded per instruction
+		std::vector<std::pair<int, u64>> m_registers;   // state index and last recorded value of each register
+		std::unordered_map<offs_t, u32> m_opcodes;      // CRC of the opcode bytes last recorded at each PC
 	};
 	std::unique_ptr<tracer>                m_trace;                    // tracer state
 
@@ -835,7 +835,7 @@ static const help_item static_help_list[] =
 	{
 		"trace",
 		"\n"
-		"  trace {<filename>|OFF}[,<cpu>[,[noloop|logerror][,<action>]]]\n"
+		"  trace {<filename>|OFF}[,<cpu>[,[noloop|logerror|binary|memory][,<action>]]]\n"
 		"\n"
 		"Starts or stops tracing of the execution of the specified <cpu>. If <cpu> is omitted, "
 		"the currently active CPU is specified. When enabling tracing, specify the filename in the "
@@ -843,7 +843,10 @@ static const help_item static_help_list[] =
 		"<detectloops> should be either true or false. If 'noloop' is omitted, the trace "
 		"will have loops detected and condensed to a single line. If 'noloop' is specified, the trace "
 		"will contain every opcode as it is executed. If 'logerror' is specified, logerror output "
-		"will augment the trace.  If you "
+		"will augment the trace. If 'binary' is specified, the trace is written in a compact, "
+		"compressed binary form instead of as disassembly, recording the PC, opcode bytes and changed "
+		"registers of every instruction; 'memory' does the same and also records every memory access "
+		"the CPU makes. Binary traces can be read back with 'unidasm <filename> -arch <arch> -trace'. If you "
 		"wish to log additional information on each trace, you can append an <action> parameter which "
 		"is a command that is executed before each trace is logged. Generally, this is used to include "
 		"a 'tracelog' command. Note that you may need to embed the action within braces { } in order "
@@ -867,6 +870,9 @@ static const help_item static_help_list[] =
 		"trace starswep.tr,0,logerror|noloop\n"
 		"  Begin tracing the execution of CPU #0, logging output (along with logerror output) to starswep.tr, with loop detection disabled.\n"
 		"\n"
+		"trace galaga.trc,0,memory\n"
+		"  Begin a binary trace of CPU #0 to galaga.trc, including its memory accesses.\n"
+		"\n"
 		"trace >>pigskin.tr\n"
 		"  Begin tracing the currently active CPU, appending log output to pigskin.tr.\n"
 		"\n"
@@ -101,6 +101,14 @@ enum
 	TVL_EXECUTEFUNC
 };
 
+// compiled-only operations, numbered after the operators
+enum
+{
+	COP_PUSH = TVL_EXECUTEFUNC + 1,
+	COP_READ_SYMBOL,
+	COP_READ_MEMORY
+};
+
 
 
 //**************************************************************************
@@ -583,12 +591,16 @@ void parsed_expression::parse(const char *expression)
 	m_original_string.assign(expression);
 	m_tokenlist.reset();
 	m_stringlist.reset();
+	m_program.clear();
 
 	// first parse the tokens into the token array in order
 	parse_string_into_tokens();
 
 	// convert the infix order to postfix order
 	infix_to_postfix();
+
+	// and lower that to something quicker to evaluate
+	compile();
 }
 
 
@@ -600,8 +612,15 @@ void parsed_expression::copy(const parsed_expression &src)
 {
 	m_symtable = src.m_symtable;
 	m_original_string.assign(src.m_original_string);
+	m_tokenlist.reset();
+	m_stringlist.reset();
+	m_program.clear();
 	if (!m_original_string.empty())
+	{
 		parse_string_into_tokens();
+		infix_to_postfix();
+		compile();
+	}
 }
 
 
@@ -1684,6 +1703,341 @@ u64 parsed_expression::execute_tokens()
 	return result.value();
 }
 
+//-------------------------------------------------
+//  compile - lower the postfix token list to a
+//  flat program over a stack of plain values;
+//  anything that would fail at runtime is left
+//  to execute_tokens so errors are reported the
+//  same way
+//-------------------------------------------------
+
+bool parsed_expression::compile()
+{
+	m_program.clear();
+
+	// simulate the token stack: symbols and memory stay unresolved until an
+	// operator pops them, just like in execute_tokens
+	parse_token stack[MAX_STACK_DEPTH];
+	int sp = 0;
+	int result_offset = 0;
+
+	auto emit = [this] (u8 opcode, int offset) -> compiled_op &
+	{
+		compiled_op op = { opcode, 0, 0, 0, false, offset, 0, nullptr, nullptr };
+		m_program.push_back(op);
+		return m_program.back();
+	};
+	auto set_lval = [] (compiled_op &op, const parse_token &lval)
+	{
+		if (lval.is_symbol())
+			op.symbol = lval.symbol();
+		else
+		{
+			op.memory_space = lval.memory_space();
+			op.memory_size = lval.memory_size();
+			op.memory_side_effect = lval.memory_side_effect();
+			op.string = lval.memory_source();
+		}
+	};
+
+	// resolve the entry some way down the stack to a number
+	auto rval = [&] (int depth) -> bool
+	{
+		if (sp <= depth)
+			return false;
+		parse_token &entry = stack[sp - 1 - depth];
+		if (entry.is_symbol())
+		{
+			if (entry.symbol()->is_function())
+				return false;
+			compiled_op &op = emit(COP_READ_SYMBOL, entry.offset());
+			op.depth = depth;
+			op.symbol = entry.symbol();
+		}
+		else if (entry.is_memory())
+		{
+			compiled_op &op = emit(COP_READ_MEMORY, entry.offset());
+			op.depth = depth;
+			set_lval(op, entry);
+		}
+		else if (!entry.is_number())
+			return false;
+		entry.configure_number(0);
+		return true;
+	};
+	auto lval = [&] (int depth) -> bool
+	{
+		return sp > depth && stack[sp - 1 - depth].is_lval();
+	};
+	auto push = [&] (const parse_token &token) -> bool
+	{
+		if (sp >= MAX_STACK_DEPTH)
+			return false;
+		stack[sp++] = token;
+		return true;
+	};
+
+	for (parse_token &token : m_tokenlist)
+	{
+		// numbers are pushed as constants, everything else as a placeholder
+		if (!token.is_operator())
+		{
+			if (!push(token))
+				return false;
+			compiled_op &op = emit(COP_PUSH, token.offset());
+			if (token.is_number())
+				op.value = token.value();
+			continue;
+		}
+
+		switch (token.optype())
+		{
+			case TVL_PREINCREMENT:
+			case TVL_PREDECREMENT:
+			case TVL_POSTINCREMENT:
+			case TVL_POSTDECREMENT:
+				if (!lval(0))
+					goto fail;
+				set_lval(emit(token.optype(), token.offset()), stack[sp - 1]);
+				stack[sp - 1].configure_number(0);
+				result_offset = stack[sp - 1].offset();
+				break;
+
+			case TVL_COMPLEMENT:
+			case TVL_NOT:
+			case TVL_UPLUS:
+			case TVL_UMINUS:
+				if (!rval(0))
+					goto fail;
+				emit(token.optype(), token.offset());
+				result_offset = stack[sp - 1].offset();
+				break;
+
+			case TVL_MULTIPLY:
+			case TVL_DIVIDE:
+			case TVL_MODULO:
+			case TVL_ADD:
+			case TVL_SUBTRACT:
+			case TVL_LSHIFT:
+			case TVL_RSHIFT:
+			case TVL_LESS:
+			case TVL_LESSOREQUAL:
+			case TVL_GREATER:
+			case TVL_GREATEROREQUAL:
+			case TVL_EQUAL:
+			case TVL_NOTEQUAL:
+			case TVL_BAND:
+			case TVL_BXOR:
+			case TVL_BOR:
+			case TVL_LAND:
+			case TVL_LOR:
+				if (!rval(0) || !rval(1))
+					goto fail;
+				emit(token.optype(), stack[sp - 1].offset());
+				result_offset = std::min(stack[sp - 2].offset(), stack[sp - 1].offset());
+				stack[sp - 2].set_offset(result_offset);
+				sp--;
+				break;
+
+			case TVL_ASSIGN:
+			case TVL_ASSIGNMULTIPLY:
+			case TVL_ASSIGNDIVIDE:
+			case TVL_ASSIGNMODULO:
+			case TVL_ASSIGNADD:
+			case TVL_ASSIGNSUBTRACT:
+			case TVL_ASSIGNLSHIFT:
+			case TVL_ASSIGNRSHIFT:
+			case TVL_ASSIGNBAND:
+			case TVL_ASSIGNBXOR:
+			case TVL_ASSIGNBOR:
+				if (!rval(0) || !lval(1))
+					goto fail;
+				set_lval(emit(token.optype(), stack[sp - 1].offset()), stack[sp - 2]);
+				if (token.optype() == TVL_ASSIGN)
+					result_offset = stack[sp - 1].offset();
+				else
+					result_offset = std::min(stack[sp - 2].offset(), stack[sp - 1].offset());
+				stack[sp - 2].configure_number(0).set_offset(result_offset);
+				sp--;
+				break;
+
+			case TVL_COMMA:
+				if (!token.is_function_separator())
+				{
+					if (!rval(0) || !rval(1))
+						goto fail;
+					emit(TVL_COMMA, token.offset());
+					stack[sp - 2] = stack[sp - 1];
+					sp--;
+				}
+				break;
+
+			case TVL_MEMORYAT:
+				// the address stays on the stack; the read happens when it is consumed
+				if (!rval(0))
+					goto fail;
+				stack[sp - 1].configure_memory(0, token).set_offset(result_offset);
+				break;
+
+			case TVL_EXECUTEFUNC:
+			{
+				int paramcount = 0;
+				while (paramcount < MAX_FUNCTION_PARAMS && sp > paramcount)
+				{
+					const parse_token &entry = stack[sp - 1 - paramcount];
+					if (entry.is_symbol() && entry.symbol()->is_function())
+						break;
+					if (!rval(paramcount))
+						goto fail;
+					paramcount++;
+				}
+				if (paramcount == MAX_FUNCTION_PARAMS || sp == paramcount)
+					goto fail;
+				compiled_op &op = emit(TVL_EXECUTEFUNC, token.offset());
+				op.value = paramcount;
+				op.symbol = stack[sp - 1 - paramcount].symbol();
+				sp -= paramcount;
+				stack[sp - 1].configure_number(0).set_offset(token.offset());
+				break;
+			}
+
+			default:
+				goto fail;
+		}
+	}
+
+	// the final result must be the only thing left on the stack
+	if (sp == 1 && rval(0))
+		return true;
+
+fail:
+	m_program.clear();
+	return false;
+}
+
+
+//-------------------------------------------------
+//  compiled_lval_value - read an lval of a
+//  compiled operation
+//-------------------------------------------------
+
+inline u64 parsed_expression::compiled_lval_value(const compiled_op &op, u64 address)
+{
+	if (op.symbol != nullptr)
+		return op.symbol->value();
+	else if (m_symtable != nullptr)
+		return m_symtable->memory_value(op.string, expression_space(op.memory_space), u32(address), 1 << op.memory_size, op.memory_side_effect);
+	return 0;
+}
+
+
+//-------------------------------------------------
+//  compiled_set_lval_value - write an lval of a
+//  compiled operation
+//-------------------------------------------------
+
+inline void parsed_expression::compiled_set_lval_value(const compiled_op &op, u64 address, u64 value)
+{
+	if (op.symbol != nullptr)
+		op.symbol->set_value(value);
+	else if (m_symtable != nullptr)
+		m_symtable->set_memory_value(op.string, expression_space(op.memory_space), u32(address), 1 << op.memory_size, value, op.memory_side_effect);
+}
+
+
+//-------------------------------------------------
+//  execute_compiled - run the program built by
+//  compile
+//-------------------------------------------------
+
+u64 parsed_expression::execute_compiled()
+{
+	u64 stack[MAX_STACK_DEPTH];
+	u64 *sp = stack;
+	u64 t1, t2;
+
+	for (const compiled_op &op : m_program)
+	{
+		switch (op.opcode)
+		{
+			case COP_PUSH:              *sp++ = op.value;                                               break;
+			case COP_READ_SYMBOL:       sp[-1 - op.depth] = op.symbol->value();                         break;
+			case COP_READ_MEMORY:       sp[-1 - op.depth] = compiled_lval_value(op, sp[-1 - op.depth]); break;
+
+			case TVL_PREINCREMENT:      t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) + 1; compiled_set_lval_value(op, t1, sp[-1]);       break;
+			case TVL_PREDECREMENT:      t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) - 1; compiled_set_lval_value(op, t1, sp[-1]);       break;
+			case TVL_POSTINCREMENT:     t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1); compiled_set_lval_value(op, t1, sp[-1] + 1);      break;
+			case TVL_POSTDECREMENT:     t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1); compiled_set_lval_value(op, t1, sp[-1] - 1);      break;
+
+			case TVL_COMPLEMENT:        sp[-1] = !sp[-1];                                               break;
+			case TVL_NOT:               sp[-1] = ~sp[-1];                                               break;
+			case TVL_UPLUS:                                                                             break;
+			case TVL_UMINUS:            sp[-1] = -sp[-1];                                               break;
+
+			case TVL_MULTIPLY:          t2 = *--sp; sp[-1] *= t2;                                       break;
+			case TVL_DIVIDE:
+				t2 = *--sp;
+				if (t2 == 0)
+					throw expression_error(expression_error::DIVIDE_BY_ZERO, op.offset);
+				sp[-1] /= t2;
+				break;
+			case TVL_MODULO:
+				t2 = *--sp;
+				if (t2 == 0)
+					throw expression_error(expression_error::DIVIDE_BY_ZERO, op.offset);
+				sp[-1] %= t2;
+				break;
+			case TVL_ADD:               t2 = *--sp; sp[-1] += t2;                                       break;
+			case TVL_SUBTRACT:          t2 = *--sp; sp[-1] -= t2;                                       break;
+			case TVL_LSHIFT:            t2 = *--sp; sp[-1] <<= t2;                                      break;
+			case TVL_RSHIFT:            t2 = *--sp; sp[-1] >>= t2;                                      break;
+			case TVL_LESS:              t2 = *--sp; sp[-1] = sp[-1] < t2;                               break;
+			case TVL_LESSOREQUAL:       t2 = *--sp; sp[-1] = sp[-1] <= t2;                              break;
+			case TVL_GREATER:           t2 = *--sp; sp[-1] = sp[-1] > t2;                               break;
+			case TVL_GREATEROREQUAL:    t2 = *--sp; sp[-1] = sp[-1] >= t2;                              break;
+			case TVL_EQUAL:             t2 = *--sp; sp[-1] = sp[-1] == t2;                              break;
+			case TVL_NOTEQUAL:          t2 = *--sp; sp[-1] = sp[-1] != t2;                              break;
+			case TVL_BAND:              t2 = *--sp; sp[-1] &= t2;                                       break;
+			case TVL_BXOR:              t2 = *--sp; sp[-1] ^= t2;                                       break;
+			case TVL_BOR:               t2 = *--sp; sp[-1] |= t2;                                       break;
+			case TVL_LAND:              t2 = *--sp; sp[-1] = sp[-1] && t2;                              break;
+			case TVL_LOR:               t2 = *--sp; sp[-1] = sp[-1] || t2;                              break;
+			case TVL_COMMA:             t2 = *--sp; sp[-1] = t2;                                        break;
+
+			case TVL_ASSIGN:
+				t2 = *--sp; t1 = sp[-1];
+				sp[-1] = t2;
+				compiled_set_lval_value(op, t1, t2);
+				break;
+
+			case TVL_ASSIGNDIVIDE:
+			case TVL_ASSIGNMODULO:
+				t2 = *--sp; t1 = sp[-1];
+				if (t2 == 0)
+					throw expression_error(expression_error::DIVIDE_BY_ZERO, op.offset);
+				sp[-1] = (op.opcode == TVL_ASSIGNDIVIDE) ? (compiled_lval_value(op, t1) / t2) : (compiled_lval_value(op, t1) % t2);
+				compiled_set_lval_value(op, t1, sp[-1]);
+				break;
+
+			case TVL_ASSIGNMULTIPLY:    t2 = *--sp; t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) * t2;  compiled_set_lval_value(op, t1, sp[-1]); break;
+			case TVL_ASSIGNADD:         t2 = *--sp; t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) + t2;  compiled_set_lval_value(op, t1, sp[-1]); break;
+			case TVL_ASSIGNSUBTRACT:    t2 = *--sp; t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) - t2;  compiled_set_lval_value(op, t1, sp[-1]); break;
+			case TVL_ASSIGNLSHIFT:      t2 = *--sp; t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) << t2; compiled_set_lval_value(op, t1, sp[-1]); break;
+			case TVL_ASSIGNRSHIFT:      t2 = *--sp; t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) >> t2; compiled_set_lval_value(op, t1, sp[-1]); break;
+			case TVL_ASSIGNBAND:        t2 = *--sp; t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) & t2;  compiled_set_lval_value(op, t1, sp[-1]); break;
+			case TVL_ASSIGNBXOR:        t2 = *--sp; t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) ^ t2;  compiled_set_lval_value(op, t1, sp[-1]); break;
+			case TVL_ASSIGNBOR:         t2 = *--sp; t1 = sp[-1]; sp[-1] = compiled_lval_value(op, t1) | t2;  compiled_set_lval_value(op, t1, sp[-1]); break;
+
+			case TVL_EXECUTEFUNC:
+				sp -= op.value;
+				sp[-1] = downcast<function_symbol_entry *>(op.symbol)->execute(int(op.value), sp);
+				break;
+		}
+	}
+
+	return sp[-1];
+}
+
 
 
 //**************************************************************************
@@ -16,6 +16,7 @@
 #include "emucore.h"
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 
 
@@ -198,6 +199,10 @@ public:
 	u64 memory_value(const char *name, expression_space space, u32 offset, int size, bool with_se);
 	void set_memory_value(const char *name, expression_space space, u32 offset, int size, u64 value, bool with_se);
 
+	// memory callbacks, for tables that forward to this one
+	void *memory_param() const { return m_memory_param; }
+	const read_func &memory_reader() const { return m_memory_read; }
+
 private:
 	// internal state
 	symbol_table *          m_parent;           // pointer to the parent symbol table
@@ -234,7 +239,7 @@ public:
 
 	// execution
 	void parse(const char *string);
-	u64 execute() { return execute_tokens(); }
+	u64 execute() { return m_program.empty() ? execute_tokens() : execute_compiled(); }
 
 private:
 	// a single token
@@ -298,6 +303,7 @@ private:
 		expression_space memory_space() const { assert(m_type == OPERATOR || m_type == MEMORY); return expression_space((m_flags & TIN_MEMORY_SPACE_MASK) >> TIN_MEMORY_SPACE_SHIFT); }
 		int memory_size() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_MEMORY_SIZE_MASK) >> TIN_MEMORY_SIZE_SHIFT; }
 		bool memory_side_effect() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_SIDE_EFFECT_MASK) >> TIN_SIDE_EFFECT_SHIFT; }
+		const char *memory_source() const { assert(m_type == OPERATOR || m_type == MEMORY); return m_string; }
 
 		// setters
 		parse_token &set_offset(int offset) { m_offset = offset; return *this; }
@@ -353,6 +359,21 @@ private:
 		std::string         m_string;                   // copy of the string
 	};
 
+	// a compiled operation; the token stack becomes a stack of plain values, and
+	// symbols and memory are only read when an operator consumes them
+	struct compiled_op
+	{
+		u8                  opcode;             // operator, or one of the compiled-only opcodes
+		u8                  depth;              // stack slot to resolve, counting down from the top
+		u8                  memory_space;       // space of the memory to access
+		u8                  memory_size;        // log2 of the size of the memory to access
+		bool                memory_side_effect; // whether memory accesses have side effects
+		int                 offset;             // offset within the string, for errors
+		u64                 value;              // constant or parameter count
+		symbol_entry *      symbol;             // symbol to read, write or call
+		const char *        string;             // memory source name
+	};
+
 	// internal helpers
 	void copy(const parsed_expression &src);
 	void print_tokens(FILE *out);
@@ -376,6 +397,12 @@ private:
 	u64 execute_tokens();
 	void execute_function(parse_token &token);
 
+	// compilation helpers
+	bool compile();
+	u64 execute_compiled();
+	u64 compiled_lval_value(const compiled_op &op, u64 address);
+	void compiled_set_lval_value(const compiled_op &op, u64 address, u64 value);
+
 	// constants
 	static const int MAX_FUNCTION_PARAMS = 16;
 	static const int MAX_STACK_DEPTH = 16;
@@ -385,6 +412,7 @@ private:
 	std::string         m_original_string;              // original string (prior to parsing)
 	simple_list<parse_token> m_tokenlist;               // token list
 	simple_list<expression_string> m_stringlist;        // string list
+	std::vector<compiled_op> m_program;                 // compiled form of the token list, if it has one
 	int                 m_token_stack_ptr;              // stack pointer (used during execution)
 	parse_token         m_token_stack[MAX_STACK_DEPTH]; // token stack (used during execution)
 };
@@ -565,7 +565,7 @@ public:
 
 	// getters
 	virtual handler_entry &handler(u32 index) const = 0;
-	bool watchpoints_enabled() const { return (m_live_lookup == s_watchpoint_table); }
+	bool watchpoints_enabled() const { return (m_live_lookup != &m_table[0]); }
 
 	// address lookups
 	u32 lookup_live(offs_t byteaddress) const { return m_large ? lookup_live_large(byteaddress) : lookup_live_small(byteaddress); }
@@ -598,8 +598,12 @@ public:
 		return entry;
 	}
 
-	// enable watchpoints by swapping in the watchpoint table
-	void enable_watchpoints(bool enable = true) { m_live_lookup = enable ? s_watchpoint_table : &m_table[0]; }
+	// enable watchpoints by swapping in the watchpoint table, or a copy of our
+	// table with just the watched pages diverted; while that copy is stale
+	// everything goes through the watchpoint handler, which refreshes it
+	void enable_watchpoints(bool enable = true) { m_watch_all = enable; update_live_lookup(); }
+	void set_watchpoint_ranges(std::vector<std::pair<offs_t, offs_t>> ranges) { m_watch_ranges = std::move(ranges); watch_table_rebuild(); }
+	void update_live_lookup() { m_live_lookup = (m_watch_all || m_watch_dirty) ? s_watchpoint_table : !m_watch_table.empty() ? &m_watch_table[0] : &m_table[0]; }
 
 	// table mapping helpers
 	void map_range(offs_t bytestart, offs_t byteend, offs_t bytemask, offs_t bytemirror, u16 staticentry);
@@ -621,6 +625,11 @@ protected:
 	void populate_range_mirrored(offs_t bytestart, offs_t byteend, offs_t bytemirror, u16 handler);
 	void populate_range(offs_t bytestart, offs_t byteend, u16 handler);
 
+	// watchpoint table management
+	void watch_table_rebuild();
+	void watch_table_invalidate() { if (!m_watch_ranges.empty()) { m_watch_dirty = true; update_live_lookup(); } }
+	bool watch_table_hit(offs_t byteaddress);
+
 	// subtable management
 	u16 subtable_alloc();
 	void subtable_realloc(u16 subentry);
@@ -635,6 +644,10 @@ protected:
 	u16 *                m_live_lookup;              // current lookup
 	address_space &         m_space;                    // pointer back to the space
 	bool                    m_large;                    // large memory model?
+	std::vector<u16>        m_watch_table;              // copy of the table with watched pages diverted
+	std::vector<std::pair<offs_t, offs_t>> m_watch_ranges; // watched byte ranges
+	bool                    m_watch_all;                // divert every access?
+	bool                    m_watch_dirty;              // watch table needs rebuilding?
 
 	// subtable_data is an internal class with information about each subtable
 	class subtable_data
@@ -738,16 +751,18 @@ private:
 	template<typename _UintType>
 	_UintType watchpoint_r(address_space &space, offs_t offset, _UintType mask)
 	{
-		m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
+		if (watch_table_hit(offset * sizeof(_UintType)))
+			m_space.device().debug()->memory_read_hook(m_space, offset * sizeof(_UintType), mask);
 
-		u16 *oldtable = m_live_lookup;
+		// the hook may have changed the watchpoints, so look the table up again
+		// afterwards rather than restoring the old one
 		m_live_lookup = &m_table[0];
 		_UintType result;
 		if (sizeof(_UintType) == 1) result = m_space.read_byte(offset);
 		if (sizeof(_UintType) == 2) result = m_space.read_word(offset << 1, mask);
 		if (sizeof(_UintType) == 4) result = m_space.read_dword(offset << 2, mask);
 		if (sizeof(_UintType) == 8) result = m_space.read_qword(offset << 3, mask);
-		m_live_lookup = oldtable;
+		update_live_lookup();
 		return result;
 	}
 
@@ -806,15 +821,15 @@ private:
 	template<typename _UintType>
 	void watchpoint_w(address_space &space, offs_t offset, _UintType data, _UintType mask)
 	{
-		m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
+		if (watch_table_hit(offset * sizeof(_UintType)))
+			m_space.device().debug()->memory_write_hook(m_space, offset * sizeof(_UintType), data, mask);
 
-		u16 *oldtable = m_live_lookup;
 		m_live_lookup = &m_table[0];
 		if (sizeof(_UintType) == 1) m_space.write_byte(offset, data);
 		if (sizeof(_UintType) == 2) m_space.write_word(offset << 1, data, mask);
 		if (sizeof(_UintType) == 4) m_space.write_dword(offset << 2, data, mask);
 		if (sizeof(_UintType) == 8) m_space.write_qword(offset << 3, data, mask);
-		m_live_lookup = oldtable;
+		update_live_lookup();
 	}
 
 	// internal state
@@ -1043,6 +1058,8 @@ public:
 	// watchpoint control
 	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); }
 	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); }
+	virtual void set_read_watchpoint_ranges(std::vector<std::pair<offs_t, offs_t>> ranges) override { m_read.set_watchpoint_ranges(std::move(ranges)); }
+	virtual void set_write_watchpoint_ranges(std::vector<std::pair<offs_t, offs_t>> ranges) override { m_write.set_watchpoint_ranges(std::move(ranges)); }
 
 	// generate accessor table
 	virtual void accessors(data_accessors &accessors) const override
@@ -2930,6 +2947,8 @@ address_table::address_table(address_space &space, bool large)
 	: m_table(1 << LEVEL1_BITS),
 		m_space(space),
 		m_large(large),
+		m_watch_all(false),
+		m_watch_dirty(false),
 		m_subtable(SUBTABLE_COUNT),
 		m_subtable_alloc(0)
 {
@@ -2990,6 +3009,7 @@ void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask,
 
 	// populate it
 	populate_range_mirrored(bytestart, byteend, bytemirror, entry);
+	watch_table_invalidate();
 
 	// recompute any direct access on this space if it is a read modification
 	m_space.m_direct->force_update(entry);
@@ -3164,6 +3184,8 @@ void address_table::setup_range_masked(offs_t addrstart, offs_t addrend, offs_t
 		}
 	}
 
+	watch_table_invalidate();
+
 	//  verify_reference_counts();
 }
 
@@ -3298,6 +3320,61 @@ void address_table::populate_range(offs_t bytestart, offs_t byteend, u16 handler
 }
 
 
+//-------------------------------------------------
+//  watch_table_rebuild - make a copy of the table
+//  with the entries covering each watched range
+//  diverted to the watchpoint handler
+//-------------------------------------------------
+
+void address_table::watch_table_rebuild()
+{
+	m_watch_dirty = false;
+	if (m_watch_ranges.empty())
+		m_watch_table.clear();
+	else
+	{
+		// subtables are copied as well, so unwatched pages resolve unchanged
+		m_watch_table = m_table;
+		const offs_t l1mask = (1 << LEVEL1_BITS) - 1;
+		for (const auto &range : m_watch_ranges)
+		{
+			// widen to a qword so that wide accesses overlapping the range are caught
+			const offs_t bytestart = range.first & ~7;
+			const offs_t byteend = range.second | 7;
+			if (bytestart > byteend)
+				continue;
+
+			// large tables divert whole level 1 entries; small ones are indexed by byte
+			offs_t l1start = bytestart >> level2_bits();
+			offs_t l1stop = byteend >> level2_bits();
+			if (l1start > l1mask)
+				continue;
+			l1stop = std::min(l1stop, l1mask);
+			for (offs_t l1index = l1start; l1index <= l1stop; l1index++)
+				m_watch_table[l1index] = STATIC_WATCHPOINT;
+		}
+	}
+	update_live_lookup();
+}
+
+
+//-------------------------------------------------
+//  watch_table_hit - called from the watchpoint
+//  handlers; mapping changes only mark the watch
+//  table stale, so a run of them costs a single
+//  rebuild here on the next access, after which
+//  the address is checked against the new table
+//-------------------------------------------------
+
+bool address_table::watch_table_hit(offs_t byteaddress)
+{
+	if (!m_watch_dirty)
+		return true;
+	watch_table_rebuild();
+	return m_watch_all || lookup(byteaddress) == STATIC_WATCHPOINT;
+}
+
+
 //-------------------------------------------------
 //  populate_range_mirrored - assign a memory
 //  handler to a range of addresses including
@@ -294,9 +294,12 @@ public:
 	void set_log_unmap(bool log) { m_log_unmap = log; }
 	void dump_map(FILE *file, read_or_write readorwrite);
 
-	// watchpoint enablers
+	// watchpoint enablers; enabling hooks every access, while ranges (inclusive
+	// byte addresses) only hook accesses to the pages that contain them
 	virtual void enable_read_watchpoints(bool enable = true) = 0;
 	virtual void enable_write_watchpoints(bool enable = true) = 0;
+	virtual void set_read_watchpoint_ranges(std::vector<std::pair<offs_t, offs_t>> ranges) = 0;
+	virtual void set_write_watchpoint_ranges(std::vector<std::pair<offs_t, offs_t>> ranges) = 0;
 
 	// general accessors
 	virtual void accessors(data_accessors &accessors) const = 0;
@@ -77,10 +77,13 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_AUTOFRAMESKIP ";afs",                       "0",         OPTION_BOOLEAN,    "enable automatic frameskip selection" },
 	{ OPTION_FRAMESKIP ";fs(0-10)",                      "0",         OPTION_INTEGER,    "set frameskip to fixed value, 0-10 (autoframeskip must be disabled)" },
 	{ OPTION_SECONDS_TO_RUN ";str",                      "0",         OPTION_INTEGER,    "number of emulated seconds to run before automatically exiting" },
+	{ OPTION_BENCH_REPORT,                               nullptr,     OPTION_STRING,     "directory to write a JSON report of per-frame screen and sound hashes and host timings to" },
 	{ OPTION_THROTTLE,                                   "1",         OPTION_BOOLEAN,    "enable throttling to keep game running in sync with real time" },
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
+	{ OPTION_DEADLINE_THROTTLE,                          "0",         OPTION_BOOLEAN,    "throttle by sleeping until just before each frame's deadline and spinning the rest, for steadier frame pacing" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
+	{ OPTION_RUNAHEAD "(0-4)",                           "0",         OPTION_INTEGER,    "number of frames to emulate ahead of the one shown, to hide the system's own input latency; needs save state support" },
 
 	// render options
 	{ nullptr,                                           nullptr,     OPTION_HEADER,     "CORE RENDER OPTIONS" },
@@ -191,6 +194,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UI_FONT,                                    "default",   OPTION_STRING,     "specify a font to use" },
 	{ OPTION_UI,                                         "cabinet",   OPTION_STRING,     "type of UI (simple|cabinet)" },
 	{ OPTION_RAMSIZE ";ram",                             nullptr,     OPTION_STRING,     "size of RAM (if supported by driver)" },
+	{ OPTION_HASH_CACHE,                                 nullptr,     OPTION_STRING,     "file to cache archive contents and ROM hashes in; unchanged files are not read again" },
+	{ OPTION_DRIVER_CACHE,                               nullptr,     OPTION_STRING,     "file to cache per-system ROM, device and media information in for list commands" },
+	{ OPTION_AUDIT_THREADS ";at",                        "1",         OPTION_INTEGER,    "number of threads used to verify ROM sets (0 = one per processor)" },
 	{ OPTION_CONFIRM_QUIT,                               "0",         OPTION_BOOLEAN,    "display confirm quit screen on exit" },
 	{ OPTION_UI_MOUSE,                                   "1",         OPTION_BOOLEAN,    "display ui mouse cursor" },
 	{ OPTION_AUTOBOOT_COMMAND ";ab",                     nullptr,     OPTION_STRING,     "command to execute after machine boot" },
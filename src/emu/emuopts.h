@@ -70,10 +70,13 @@
 #define OPTION_AUTOFRAMESKIP        "autoframeskip"
 #define OPTION_FRAMESKIP            "frameskip"
 #define OPTION_SECONDS_TO_RUN       "seconds_to_run"
+#define OPTION_BENCH_REPORT         "benchreport"
 #define OPTION_THROTTLE             "throttle"
 #define OPTION_SLEEP                "sleep"
+#define OPTION_DEADLINE_THROTTLE    "deadlinethrottle"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_RUNAHEAD             "runahead"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -167,6 +170,9 @@
 #define OPTION_UI_FONT              "uifont"
 #define OPTION_UI                   "ui"
 #define OPTION_RAMSIZE              "ramsize"
+#define OPTION_HASH_CACHE           "hashcache"
+#define OPTION_DRIVER_CACHE         "drivercache"
+#define OPTION_AUDIT_THREADS        "auditthreads"
 
 // core comm options
 #define OPTION_COMM_LOCAL_HOST      "comm_localhost"
@@ -262,10 +268,13 @@ public:
 	bool auto_frameskip() const { return bool_value(OPTION_AUTOFRAMESKIP); }
 	int frameskip() const { return int_value(OPTION_FRAMESKIP); }
 	int seconds_to_run() const { return int_value(OPTION_SECONDS_TO_RUN); }
+	const char *bench_report() const { return value(OPTION_BENCH_REPORT); }
 	bool throttle() const { return bool_value(OPTION_THROTTLE); }
 	bool sleep() const { return m_sleep; }
+	bool deadline_throttle() const { return bool_value(OPTION_DEADLINE_THROTTLE); }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
+	int runahead() const { return int_value(OPTION_RUNAHEAD); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -357,6 +366,9 @@ public:
 	const char *ui_font() const { return value(OPTION_UI_FONT); }
 	ui_option ui() const { return m_ui; }
 	const char *ram_size() const { return value(OPTION_RAMSIZE); }
+	const char *hash_cache() const { return value(OPTION_HASH_CACHE); }
+	const char *driver_cache() const { return value(OPTION_DRIVER_CACHE); }
+	int audit_threads() const { return int_value(OPTION_AUDIT_THREADS); }
 
 	// core comm options
 	const char *comm_localhost() const { return value(OPTION_COMM_LOCAL_HOST); }
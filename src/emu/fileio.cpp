@@ -15,6 +15,13 @@
 
 const u32 OPEN_FLAG_HAS_CRC  = 0x10000;
 
+namespace {
+
+// first line of a hash cache file; bump the version when changing the format
+char const HASH_CACHE_MAGIC[] = "# MAME hash cache 1";
+
+} // anonymous namespace
+
 
 
 //**************************************************************************
@@ -156,6 +163,276 @@ const osd::directory::entry *file_enumerator::next()
 
 
 
+//**************************************************************************
+//  HASH CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  hash_cache - constructor
+//-------------------------------------------------
+
+hash_cache::hash_cache()
+	: m_dirty(false)
+{
+}
+
+
+//-------------------------------------------------
+//  load - read a cache written by save; entries
+//  are checked against the file system when they
+//  are first used
+//-------------------------------------------------
+
+bool hash_cache::load(const char *filename)
+{
+	util::core_file::ptr file;
+	if (util::core_file::open(filename, OPEN_FLAG_READ, file) != osd_file::error::NONE)
+		return false;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	char buffer[4096];
+	if (!file->gets(buffer, ARRAY_LENGTH(buffer)) || strncmp(buffer, HASH_CACHE_MAGIC, strlen(HASH_CACHE_MAGIC)))
+		return false;
+
+	container *entry = nullptr;
+	while (file->gets(buffer, ARRAY_LENGTH(buffer)))
+	{
+		// strip the line ending; names may contain other whitespace
+		char *const end = buffer + strcspn(buffer, "\r\n");
+		*end = 0;
+
+		unsigned long long size;
+		long long modified;
+		int listed;
+		unsigned crc;
+		char hashes[256];
+		int offset = 0;
+		if (sscanf(buffer, "C %llu %lld %d %n", &size, &modified, &listed, &offset) == 3 && offset)
+		{
+			// C <size> <modified> <listed> <path>
+			entry = &m_containers[buffer + offset];
+			entry->exists = true;
+			entry->size = size;
+			entry->modified = modified;
+			entry->current = false;
+			entry->listed = listed != 0;
+			entry->members.clear();
+		}
+		else if (entry && sscanf(buffer, "M %x %llu %255s %n", &crc, &size, hashes, &offset) == 3 && offset)
+		{
+			// M <crc> <length> <hashes> <name>
+			entry->members.push_back(member{ buffer + offset, crc, size, util::hash_collection(hashes) });
+		}
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  save - write out the cache if anything has
+//  changed since it was loaded
+//-------------------------------------------------
+
+bool hash_cache::save(const char *filename)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_dirty)
+		return true;
+
+	util::core_file::ptr file;
+	if (util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file) != osd_file::error::NONE)
+		return false;
+
+	file->printf("%s\n", HASH_CACHE_MAGIC);
+	for (auto const &entry : m_containers)
+	{
+		// don't bother remembering files that don't exist
+		if (!entry.second.exists)
+			continue;
+
+		file->printf("C %u %d %d %s\n", entry.second.size, entry.second.modified, entry.second.listed ? 1 : 0, entry.first);
+		for (member const &item : entry.second.members)
+		{
+			std::string const hashes(item.hashes.internal_string());
+			if (!hashes.empty())
+				file->printf("M %08X %u %s %s\n", item.crc, item.length, hashes, item.name);
+		}
+	}
+	m_dirty = false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  may_contain - returns false if the archive is
+//  known not to contain a file matching the name
+//  or CRC, so it needn't be opened at all
+//-------------------------------------------------
+
+bool hash_cache::may_contain(const std::string &archive, const std::string &filename, bool has_crc, u32 crc)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	container &entry = validate(lock, archive);
+	if (!entry.exists)
+		return false;
+	if (!entry.listed)
+		return true;
+
+	// match the same way as archive_file::search, including partial paths
+	for (member const &item : entry.members)
+	{
+		if (has_crc && (item.crc == crc))
+			return true;
+		if (!core_stricmp(item.name.c_str(), filename.c_str()))
+			return true;
+		if ((item.name.length() > filename.length()) && (item.name[item.name.length() - filename.length() - 1] == '/') && !core_stricmp(item.name.c_str() + item.name.length() - filename.length(), filename.c_str()))
+			return true;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  add_archive - record the directory of an
+//  archive that was just opened
+//-------------------------------------------------
+
+void hash_cache::add_archive(const std::string &archive, util::archive_file &zip)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	container &entry = validate(lock, archive);
+	if (!entry.exists || entry.listed)
+		return;
+
+	for (int header = zip.first_file(); header >= 0; header = zip.next_file())
+	{
+		if (zip.current_is_directory())
+			continue;
+
+		// keep any hashes we already know about
+		member *const item = find_member(entry, true, zip.current_crc(), zip.current_uncompressed_length());
+		if (item && item->name.empty())
+		{
+			item->name = zip.current_name();
+		}
+		else if (!item)
+		{
+			util::hash_collection hashes;
+			hashes.add_crc(zip.current_crc());
+			entry.members.push_back(member{ zip.current_name(), zip.current_crc(), zip.current_uncompressed_length(), std::move(hashes) });
+		}
+	}
+	entry.listed = true;
+	m_dirty = true;
+}
+
+
+//-------------------------------------------------
+//  find_hashes - retrieve cached hashes for a
+//  file; fails unless all requested types are
+//  known
+//-------------------------------------------------
+
+bool hash_cache::find_hashes(const std::string &path, bool archived, u32 crc, u64 length, const char *types, util::hash_collection &hashes)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	container &entry = validate(lock, path);
+	if (!entry.exists)
+		return false;
+
+	member const *const item = find_member(entry, archived, crc, length);
+	if (!item)
+		return false;
+
+	std::string const have(item->hashes.hash_types());
+	for (const char *scan = types; *scan != 0; scan++)
+		if (have.find_first_of(*scan) == std::string::npos)
+			return false;
+
+	hashes = item->hashes;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  add_hashes - remember hashes computed for a
+//  file
+//-------------------------------------------------
+
+void hash_cache::add_hashes(const std::string &path, bool archived, u32 crc, u64 length, const util::hash_collection &hashes)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	container &entry = validate(lock, path);
+	if (!entry.exists)
+		return;
+
+	member *const item = find_member(entry, archived, crc, length);
+	if (item)
+		item->hashes = hashes;
+	else
+		entry.members.push_back(member{ std::string(), crc, length, hashes });
+	m_dirty = true;
+}
+
+
+//-------------------------------------------------
+//  validate - look up a path, checking it against
+//  the file system once per session and dropping
+//  stale information; the lock is released while
+//  the file is examined so other threads aren't
+//  held up by slow file systems
+//-------------------------------------------------
+
+hash_cache::container &hash_cache::validate(std::unique_lock<std::mutex> &lock, const std::string &path)
+{
+	container &entry = m_containers[path];
+	if (!entry.current)
+	{
+		// references to map elements survive insertions by other threads
+		lock.unlock();
+		std::unique_ptr<osd::directory::entry> const info = osd_stat(path);
+		lock.lock();
+
+		// another thread may have got here first
+		if (entry.current)
+			return entry;
+
+		bool const exists = info && (info->type == osd::directory::entry::entry_type::FILE);
+		u64 const size = exists ? info->size : 0;
+		s64 const modified = exists ? s64(info->last_modified.time_since_epoch().count()) : 0;
+		if (!exists || !entry.exists || (size != entry.size) || (modified != entry.modified))
+		{
+			if (entry.exists)
+				m_dirty = true;
+			entry.exists = exists;
+			entry.size = size;
+			entry.modified = modified;
+			entry.listed = false;
+			entry.members.clear();
+		}
+		entry.current = true;
+	}
+	return entry;
+}
+
+
+//-------------------------------------------------
+//  find_member - find a member of an archive by
+//  CRC and length, or the entry for a loose file
+//-------------------------------------------------
+
+hash_cache::member *hash_cache::find_member(container &entry, bool archived, u32 crc, u64 length)
+{
+	for (member &item : entry.members)
+	{
+		if (archived ? ((item.crc == crc) && (item.length == length)) : (item.name.empty() && (item.length == length)))
+			return &item;
+	}
+	return nullptr;
+}
+
+
+
 //**************************************************************************
 //  EMU FILE
 //**************************************************************************
@@ -174,6 +451,7 @@ emu_file::emu_file(u32 openflags)
 	, m_ziplength(0)
 	, m_remove_on_close(false)
 	, m_restrict_to_mediapath(false)
+	, m_hash_cache(nullptr)
 {
 	// sanity check the open flags
 	if ((m_openflags & OPEN_FLAG_HAS_CRC) && (m_openflags & OPEN_FLAG_WRITE))
@@ -190,6 +468,7 @@ emu_file::emu_file(std::string &&searchpath, u32 openflags)
 	, m_ziplength(0)
 	, m_remove_on_close(false)
 	, m_restrict_to_mediapath(false)
+	, m_hash_cache(nullptr)
 {
 	// sanity check the open flags
 	if ((m_openflags & OPEN_FLAG_HAS_CRC) && (m_openflags & OPEN_FLAG_WRITE))
@@ -243,26 +522,48 @@ util::hash_collection &emu_file::hashes(const char *types)
 	if (needed.empty())
 		return m_hashes;
 
+	// archive members are identified by the CRC from the archive directory
+	bool const archived = !m_archivepath.empty();
+	u32 crc = 0;
+	if (archived)
+		m_hashes.crc(crc);
+
+	// use cached hashes if the file hasn't changed
+	if (m_hash_cache && (archived || m_file))
+	{
+		util::hash_collection cached;
+		if (m_hash_cache->find_hashes(archived ? m_archivepath : m_fullpath, archived, crc, archived ? m_ziplength : m_file->size(), types, cached))
+		{
+			m_hashes = cached;
+			return m_hashes;
+		}
+	}
+
 	// load the ZIP file if needed
 	if (compressed_file_ready())
 		return m_hashes;
 	if (m_file == nullptr)
 		return m_hashes;
 
-	// if we have ZIP data, just hash that directly
 	if (!m_zipdata.empty())
 	{
+		// if we have ZIP data, just hash that directly
 		m_hashes.compute(&m_zipdata[0], m_zipdata.size(), needed.c_str());
-		return m_hashes;
 	}
+	else
+	{
+		// read the data if we can
+		const u8 *filedata = (const u8 *)m_file->buffer();
+		if (filedata == nullptr)
+			return m_hashes;
 
-	// read the data if we can
-	const u8 *filedata = (const u8 *)m_file->buffer();
-	if (filedata == nullptr)
-		return m_hashes;
+		// compute the hash
+		m_hashes.compute(filedata, m_file->size(), needed.c_str());
+	}
 
-	// compute the hash
-	m_hashes.compute(filedata, m_file->size(), needed.c_str());
+	// remember them for next time
+	if (m_hash_cache)
+		m_hash_cache->add_hashes(archived ? m_archivepath : m_fullpath, archived, crc, archived ? m_ziplength : m_file->size(), m_hashes);
 	return m_hashes;
 }
 
@@ -345,6 +646,7 @@ osd_file::error emu_file::open_next()
 
 	// loop over paths
 	osd_file::error filerr = osd_file::error::NOT_FOUND;
+	m_archivepath.clear();
 	while (m_iterator.next(m_fullpath, m_filename.c_str()))
 	{
 		// attempt to open the file directly
@@ -400,6 +702,7 @@ void emu_file::close()
 	// reset our hashes and path as well
 	m_hashes.reset();
 	m_fullpath.clear();
+	m_archivepath.clear();
 }
 
 
@@ -675,9 +978,18 @@ osd_file::error emu_file::attempt_zipped()
 			m_fullpath.resize(dirsep);
 			m_fullpath.append(suffixes[i]);
 
+			// don't open archives that are known not to contain the file
+			if (m_hash_cache && !m_hash_cache->may_contain(m_fullpath, filename, (m_openflags & OPEN_FLAG_HAS_CRC) != 0, m_crc))
+			{
+				m_fullpath = m_fullpath.substr(0, dirsep);
+				continue;
+			}
+
 			// attempt to open the archive file
 			util::archive_file::ptr zip;
 			util::archive_file::error ziperr = open_funcs[i](m_fullpath, zip);
+			if (m_hash_cache && (ziperr == util::archive_file::error::NONE))
+				m_hash_cache->add_archive(m_fullpath, *zip);
 
 			// chop the archive suffix back off the filename before continuing
 			m_fullpath = m_fullpath.substr(0, dirsep);
@@ -705,6 +1017,7 @@ osd_file::error emu_file::attempt_zipped()
 			{
 				m_zipfile = std::move(zip);
 				m_ziplength = m_zipfile->current_uncompressed_length();
+				m_archivepath.assign(m_fullpath).append(suffixes[i]);
 
 				// build a hash with just the CRC
 				m_hashes.reset();
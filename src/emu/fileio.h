@@ -16,6 +16,10 @@
 #include "corefile.h"
 #include "hash.h"
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 // some systems use macros for getc/putc rather than functions
 #ifdef getc
 #undef getc
@@ -82,6 +86,59 @@ private:
 
 
 
+// ======================> hash_cache
+
+// persistent record of archive contents and file hashes; entries are keyed
+// by path and only trusted while file size and modification time match
+class hash_cache
+{
+public:
+	// construction/destruction
+	hash_cache();
+
+	// persistence
+	bool load(const char *filename);
+	bool save(const char *filename);
+
+	// archive directories
+	bool may_contain(const std::string &archive, const std::string &filename, bool has_crc, u32 crc);
+	void add_archive(const std::string &archive, util::archive_file &zip);
+
+	// file hashes; archive members are identified by CRC, loose files by path alone
+	bool find_hashes(const std::string &path, bool archived, u32 crc, u64 length, const char *types, util::hash_collection &hashes);
+	void add_hashes(const std::string &path, bool archived, u32 crc, u64 length, const util::hash_collection &hashes);
+
+private:
+	struct member
+	{
+		std::string             name;
+		u32                     crc;
+		u64                     length;
+		util::hash_collection   hashes;
+	};
+
+	struct container
+	{
+		bool                    exists;
+		u64                     size;
+		s64                     modified;
+		bool                    current;        // validated against the file system this session
+		bool                    listed;         // archive directory is complete
+		std::vector<member>     members;
+	};
+
+	// internal helpers
+	container &validate(std::unique_lock<std::mutex> &lock, const std::string &path);
+	member *find_member(container &entry, bool archived, u32 crc, u64 length);
+
+	// internal state
+	std::mutex                                  m_mutex;
+	std::unordered_map<std::string, container>  m_containers;
+	bool                                        m_dirty;
+};
+
+
+
 // ======================> emu_file
 
 class emu_file
@@ -97,6 +154,7 @@ public:
 	bool is_open() const { return bool(m_file); }
 	const char *filename() const { return m_filename.c_str(); }
 	const char *fullpath() const { return m_fullpath.c_str(); }
+	const char *archive_path() const { return m_archivepath.c_str(); }
 	u32 openflags() const { return m_openflags; }
 	util::hash_collection &hashes(const char *types);
 	bool restrict_to_mediapath() const { return m_restrict_to_mediapath; }
@@ -106,6 +164,7 @@ public:
 	void remove_on_close() { m_remove_on_close = true; }
 	void set_openflags(u32 openflags) { assert(!m_file); m_openflags = openflags; }
 	void set_restrict_to_mediapath(bool rtmp = true) { m_restrict_to_mediapath = rtmp; }
+	void set_hash_cache(hash_cache *cache) { m_hash_cache = cache; }
 
 	// open/close
 	osd_file::error open(const std::string &name);
@@ -157,6 +216,7 @@ private:
 	// internal state
 	std::string             m_filename;             // original filename provided
 	std::string             m_fullpath;             // full filename
+	std::string             m_archivepath;          // archive the file was found in
 	util::core_file::ptr    m_file;                 // core file pointer
 	path_iterator           m_iterator;             // iterator for paths
 	path_iterator           m_mediapaths;           // media-path iterator
@@ -170,6 +230,7 @@ private:
 
 	bool                    m_remove_on_close;       // flag: remove the file when closing
 	bool                    m_restrict_to_mediapath; // flag: restrict to paths inside the media-path
+	hash_cache *            m_hash_cache;            // optional cache of archive contents and hashes
 };
 
 #endif // MAME_EMU_FILEIO_H
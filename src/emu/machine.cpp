@@ -361,6 +361,10 @@ int running_machine::run(bool quiet)
 			else
 				m_video->frame_update();
 
+			// emulate ahead to the frame that gets shown
+			if (m_video->runahead_pending())
+				m_video->run_ahead();
+
 			// handle save/load
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
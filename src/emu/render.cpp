@@ -111,12 +111,30 @@ static const render_quad_texuv oriented_texcoords[8] =
 static const int layer_order_standard[] = { ITEM_LAYER_SCREEN, ITEM_LAYER_OVERLAY, ITEM_LAYER_BACKDROP, ITEM_LAYER_BEZEL, ITEM_LAYER_CPANEL, ITEM_LAYER_MARQUEE };
 static const int layer_order_alternate[] = { ITEM_LAYER_BACKDROP, ITEM_LAYER_SCREEN, ITEM_LAYER_OVERLAY, ITEM_LAYER_BEZEL, ITEM_LAYER_CPANEL, ITEM_LAYER_MARQUEE };
 
+// sequence numbers for unscaled textures and container lookup tables; shared
+// so that a recycled texture or container never repeats an earlier value
+static u32 s_render_seq = 0;
+
 
 
 //**************************************************************************
 //  INLINE FUNCTIONS
 //**************************************************************************
 
+//-------------------------------------------------
+//  hash_bytes - accumulate a 64-bit FNV-1a hash
+//  of a block of memory
+//-------------------------------------------------
+
+inline u64 hash_bytes(u64 hash, const void *data, size_t length)
+{
+	const u8 *bytes = reinterpret_cast<const u8 *>(data);
+	for (size_t index = 0; index < length; index++)
+		hash = (hash ^ bytes[index]) * 0x100000001b3U;
+	return hash;
+}
+
+
 //-------------------------------------------------
 //  apply_orientation - apply orientation to a
 //  set of bounds
@@ -219,6 +237,9 @@ void render_primitive::reset()
 //-------------------------------------------------
 
 render_primitive_list::render_primitive_list()
+	: m_refcapture(nullptr),
+		m_serial(0),
+		m_changes(CHANGED_ALL)
 {
 }
 
@@ -239,6 +260,10 @@ render_primitive_list::~render_primitive_list()
 
 inline void render_primitive_list::add_reference(void *refptr)
 {
+	// pass it on to a retained list being built alongside us
+	if (m_refcapture != nullptr)
+		m_refcapture->add_reference(refptr);
+
 	// skip if we already have one
 	if (has_reference(refptr))
 		return;
@@ -306,6 +331,30 @@ void render_primitive_list::append_or_return(render_primitive &prim, bool clippe
 }
 
 
+//-------------------------------------------------
+//  append_copy - append copies of all the
+//  primitives and references in another list
+//-------------------------------------------------
+
+void render_primitive_list::append_copy(const render_primitive_list &source)
+{
+	for (const render_primitive &prim : source.m_primlist)
+	{
+		render_primitive *copy = m_primitive_allocator.alloc();
+		*copy = prim;
+		m_primlist.append(*copy);
+	}
+
+	// references may repeat ones we already hold, which is harmless
+	for (const reference &ref : source.m_reflist)
+	{
+		reference *copy = m_reference_allocator.alloc();
+		copy->m_refptr = ref.m_refptr;
+		m_reflist.append(*copy);
+	}
+}
+
+
 
 //**************************************************************************
 //  RENDER TEXTURE
@@ -323,7 +372,9 @@ render_texture::render_texture()
 		m_osddata(~0L),
 		m_scaler(nullptr),
 		m_param(nullptr),
-		m_curseq(0)
+		m_curseq(0),
+		m_bitmapseq(0),
+		m_lookupseq(0)
 {
 	m_sbounds.set(0, -1, 0, -1);
 	memset(m_scaled, 0, sizeof(m_scaled));
@@ -379,6 +430,7 @@ void render_texture::release()
 	m_sbounds.set(0, -1, 0, -1);
 	m_format = TEXFORMAT_ARGB32;
 	m_curseq = 0;
+	m_bitmapseq = 0;
 }
 
 
@@ -398,10 +450,12 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	if (&bitmap != m_bitmap && m_bitmap != nullptr)
 		m_manager->invalidate_all(m_bitmap);
 
-	// set the new bitmap/palette
+	// set the new bitmap/palette; the new sequence number tells the OSD the
+	// contents need uploading again
 	m_bitmap = &bitmap;
 	m_sbounds = sbounds;
 	m_format = format;
+	m_bitmapseq = ++s_render_seq;
 
 	// invalidate all scaled versions
 	for (auto & elem : m_scaled)
@@ -458,7 +512,7 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 		texinfo.width = swidth;
 		texinfo.height = sheight;
 		// palette will be set later
-		texinfo.seqid = ++m_curseq;
+		texinfo.seqid = m_bitmapseq;
 	}
 	else
 	{
@@ -517,6 +571,22 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 }
 
 
+//-------------------------------------------------
+//  set_lookup_seq - note the lookup tables of the
+//  container drawing the texture, changing the
+//  sequence number if they have been modified
+//-------------------------------------------------
+
+void render_texture::set_lookup_seq(u32 lookupseq)
+{
+	if (lookupseq != m_lookupseq)
+	{
+		m_lookupseq = lookupseq;
+		m_bitmapseq = ++s_render_seq;
+	}
+}
+
+
 //-------------------------------------------------
 //  get_adjusted_palette - return the adjusted
 //  palette for a texture
@@ -566,7 +636,8 @@ render_container::render_container(render_manager &manager, screen_device *scree
 		m_manager(manager),
 		m_screen(screen),
 		m_overlaybitmap(nullptr),
-		m_overlaytexture(nullptr)
+		m_overlaytexture(nullptr),
+		m_lookupseq(0)
 {
 	// make sure it is empty
 	empty();
@@ -668,6 +739,10 @@ void render_container::add_char(float x0, float y0, float height, float aspect,
 	bounds.y0 = y0;
 	render_texture *texture = font.get_char_texture_and_bounds(height, aspect, ch, bounds);
 
+	// characters with nothing to draw, like spaces, don't need an item
+	if (texture == nullptr)
+		return;
+
 	// add it like a quad
 	item &newitem = add_generic(CONTAINER_ITEM_QUAD, bounds.x0, bounds.y0, bounds.x1, bounds.y1, argb);
 	newitem.m_texture = texture;
@@ -797,6 +872,8 @@ render_container::item &render_container::add_generic(u8 type, float x0, float y
 
 void render_container::recompute_lookups()
 {
+	m_lookupseq = ++s_render_seq;
+
 	// recompute the 256 entry lookup table
 	for (int i = 0; i < 0x100; i++)
 	{
@@ -849,6 +926,7 @@ void render_container::update_palette()
 	// iterate over dirty items and update them
 	if (dirty != nullptr)
 	{
+		m_lookupseq = ++s_render_seq;
 		palette_t &palette = m_palclient->palette();
 		const rgb_t *adjusted_palette = palette.entry_list_adjusted();
 
@@ -911,6 +989,9 @@ render_target::render_target(render_manager &manager, const internal_layout *lay
 		m_curview(nullptr),
 		m_flags(flags),
 		m_listindex(0),
+		m_listserial(0),
+		m_geometry_hash(0),
+		m_texture_hash(0),
 		m_width(640),
 		m_height(480),
 		m_pixel_aspect(0.0f),
@@ -1366,35 +1447,7 @@ render_primitive_list &render_target::get_primitives()
 			int blendmode;
 			item_layer layer = get_layer_and_blendmode(*m_curview, layernum, blendmode);
 			if (m_curview->layer_enabled(layer))
-			{
-				// iterate over items in the layer
-				for (layout_view::item &curitem : m_curview->items(layer))
-				{
-					// first apply orientation to the bounds
-					render_bounds bounds = curitem.bounds();
-					apply_orientation(bounds, root_xform.orientation);
-					normalize_bounds(bounds);
-
-					// apply the transform to the item
-					object_transform item_xform;
-					item_xform.xoffs = root_xform.xoffs + bounds.x0 * root_xform.xscale;
-					item_xform.yoffs = root_xform.yoffs + bounds.y0 * root_xform.yscale;
-					item_xform.xscale = (bounds.x1 - bounds.x0) * root_xform.xscale;
-					item_xform.yscale = (bounds.y1 - bounds.y0) * root_xform.yscale;
-					item_xform.color.r = curitem.color().r * root_xform.color.r;
-					item_xform.color.g = curitem.color().g * root_xform.color.g;
-					item_xform.color.b = curitem.color().b * root_xform.color.b;
-					item_xform.color.a = curitem.color().a * root_xform.color.a;
-					item_xform.orientation = orientation_add(curitem.orientation(), root_xform.orientation);
-					item_xform.no_center = false;
-
-					// if there is no associated element, it must be a screen element
-					if (curitem.screen() != nullptr)
-						add_container_primitives(list, root_xform, item_xform, curitem.screen()->container(), blendmode);
-					else
-						add_element_primitives(list, item_xform, *curitem.element(), curitem.state(), blendmode);
-				}
-			}
+				add_layer_primitives(list, root_xform, layer, blendmode);
 		}
 
 	// if we are not in the running stage, draw an outer box
@@ -1456,6 +1509,7 @@ render_primitive_list &render_target::get_primitives()
 
 	// optimize the list before handing it off
 	add_clear_and_optimize_primitive_list(list);
+	update_primitive_changes(list);
 	list.release_lock();
 	return list;
 }
@@ -1504,6 +1558,14 @@ void render_target::invalidate_all(void *refptr)
 			list.release_all();
 		list.release_lock();
 	}
+
+	// retained layers are only touched from this thread, so need no lock
+	for (item_layer layer = ITEM_LAYER_FIRST; layer < ITEM_LAYER_MAX; ++layer)
+		if (m_retained_primlist[layer].has_reference(refptr))
+		{
+			m_retained_primlist[layer].release_all();
+			m_retained[layer].valid = false;
+		}
 }
 
 
@@ -1910,6 +1972,7 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 					width = std::min(width, m_maxtexwidth);
 					height = std::min(height, m_maxtexheight);
 
+					curitem.texture()->set_lookup_seq(container.lookup_seq());
 					curitem.texture()->get_scaled(width, height, prim->texture, list, curitem.flags());
 
 					// set the palette
@@ -2091,6 +2154,180 @@ void render_target::add_element_primitives(render_primitive_list &list, const ob
 }
 
 
+//-------------------------------------------------
+//  add_layer_primitives - add the primitives for
+//  a layer of the current view, reusing the ones
+//  from the last frame if nothing in the layer
+//  has changed
+//-------------------------------------------------
+
+void render_target::add_layer_primitives(render_primitive_list &list, const object_transform &root_xform, item_layer layer, int blendmode)
+{
+	const simple_list<layout_view::item> &items = m_curview->items(layer);
+
+	// screens are refilled by their owners every frame, so never retain them
+	bool retainable = true;
+	for (layout_view::item &curitem : items)
+		if (curitem.screen() != nullptr)
+			retainable = false;
+	if (!retainable)
+	{
+		for (layout_view::item &curitem : items)
+			add_item_primitives(list, root_xform, curitem, blendmode);
+		return;
+	}
+
+	// gather everything the primitives depend on
+	retained_layer current;
+	current.valid = true;
+	current.view = m_curview;
+	current.blendmode = blendmode;
+	current.xoffs = root_xform.xoffs;
+	current.yoffs = root_xform.yoffs;
+	current.xscale = root_xform.xscale;
+	current.yscale = root_xform.yscale;
+	current.orientation = root_xform.orientation;
+	current.maxtexwidth = m_maxtexwidth;
+	current.maxtexheight = m_maxtexheight;
+	current.bounds = m_bounds;
+	current.items.reserve(items.count());
+	for (layout_view::item &curitem : items)
+		current.items.push_back(retained_layer::item_key{ curitem.bounds(), curitem.color(), curitem.orientation(), curitem.state() });
+
+	// if it all matches, copy the primitives we made last time
+	retained_layer &retained = m_retained[layer];
+	render_primitive_list &retained_list = m_retained_primlist[layer];
+	if (retained.matches(current))
+	{
+		list.append_copy(retained_list);
+		return;
+	}
+
+	// otherwise generate them again, keeping copies for next time
+	retained_list.release_all();
+	render_primitive *const last = list.m_primlist.last();
+	list.m_refcapture = &retained_list;
+	for (layout_view::item &curitem : items)
+		add_item_primitives(list, root_xform, curitem, blendmode);
+	list.m_refcapture = nullptr;
+	for (render_primitive *prim = (last != nullptr) ? last->next() : list.first(); prim != nullptr; prim = prim->next())
+	{
+		render_primitive *copy = retained_list.m_primitive_allocator.alloc();
+		*copy = *prim;
+		retained_list.m_primlist.append(*copy);
+	}
+	retained = std::move(current);
+}
+
+
+//-------------------------------------------------
+//  add_item_primitives - add the primitives for
+//  a single layout item
+//-------------------------------------------------
+
+void render_target::add_item_primitives(render_primitive_list &list, const object_transform &root_xform, layout_view::item &curitem, int blendmode)
+{
+	// first apply orientation to the bounds
+	render_bounds bounds = curitem.bounds();
+	apply_orientation(bounds, root_xform.orientation);
+	normalize_bounds(bounds);
+
+	// apply the transform to the item
+	object_transform item_xform;
+	item_xform.xoffs = root_xform.xoffs + bounds.x0 * root_xform.xscale;
+	item_xform.yoffs = root_xform.yoffs + bounds.y0 * root_xform.yscale;
+	item_xform.xscale = (bounds.x1 - bounds.x0) * root_xform.xscale;
+	item_xform.yscale = (bounds.y1 - bounds.y0) * root_xform.yscale;
+	item_xform.color.r = curitem.color().r * root_xform.color.r;
+	item_xform.color.g = curitem.color().g * root_xform.color.g;
+	item_xform.color.b = curitem.color().b * root_xform.color.b;
+	item_xform.color.a = curitem.color().a * root_xform.color.a;
+	item_xform.orientation = orientation_add(curitem.orientation(), root_xform.orientation);
+	item_xform.no_center = false;
+
+	// if there is no associated element, it must be a screen element
+	if (curitem.screen() != nullptr)
+		add_container_primitives(list, root_xform, item_xform, curitem.screen()->container(), blendmode);
+	else
+		add_element_primitives(list, item_xform, *curitem.element(), curitem.state(), blendmode);
+}
+
+
+//-------------------------------------------------
+//  update_primitive_changes - number a finished
+//  list and work out how it differs from the one
+//  handed out before it
+//-------------------------------------------------
+
+void render_target::update_primitive_changes(render_primitive_list &list)
+{
+	u64 geometry = 0xcbf29ce484222325U;
+	u64 textures = 0xcbf29ce484222325U;
+	for (const render_primitive &prim : list)
+	{
+		geometry = hash_bytes(geometry, &prim.type, sizeof(prim.type));
+		geometry = hash_bytes(geometry, &prim.bounds, sizeof(prim.bounds));
+		geometry = hash_bytes(geometry, &prim.full_bounds, sizeof(prim.full_bounds));
+		geometry = hash_bytes(geometry, &prim.color, sizeof(prim.color));
+		geometry = hash_bytes(geometry, &prim.flags, sizeof(prim.flags));
+		geometry = hash_bytes(geometry, &prim.width, sizeof(prim.width));
+		geometry = hash_bytes(geometry, &prim.texcoords, sizeof(prim.texcoords));
+		geometry = hash_bytes(geometry, &prim.container, sizeof(prim.container));
+		textures = hash_bytes(textures, &prim.texture.base, sizeof(prim.texture.base));
+		textures = hash_bytes(textures, &prim.texture.rowpixels, sizeof(prim.texture.rowpixels));
+		textures = hash_bytes(textures, &prim.texture.width, sizeof(prim.texture.width));
+		textures = hash_bytes(textures, &prim.texture.height, sizeof(prim.texture.height));
+		textures = hash_bytes(textures, &prim.texture.seqid, sizeof(prim.texture.seqid));
+		textures = hash_bytes(textures, &prim.texture.osddata, sizeof(prim.texture.osddata));
+		textures = hash_bytes(textures, &prim.texture.palette, sizeof(prim.texture.palette));
+	}
+
+	// the first list is always reported as entirely new
+	u32 changes = (m_listserial == 0) ? render_primitive_list::CHANGED_ALL : 0;
+	if (geometry != m_geometry_hash)
+		changes |= render_primitive_list::CHANGED_GEOMETRY;
+	if (textures != m_texture_hash)
+		changes |= render_primitive_list::CHANGED_TEXTURES;
+	m_geometry_hash = geometry;
+	m_texture_hash = textures;
+
+	list.m_serial = ++m_listserial;
+	list.m_changes = changes;
+}
+
+
+//-------------------------------------------------
+//  retained_layer::matches - return true if a
+//  retained layer was built from the same inputs
+//  as another
+//-------------------------------------------------
+
+bool render_target::retained_layer::matches(const retained_layer &other) const
+{
+	if (!valid || !other.valid || view != other.view || blendmode != other.blendmode)
+		return false;
+	if (xoffs != other.xoffs || yoffs != other.yoffs || xscale != other.xscale || yscale != other.yscale || orientation != other.orientation)
+		return false;
+	if (maxtexwidth != other.maxtexwidth || maxtexheight != other.maxtexheight)
+		return false;
+	if (bounds.x0 != other.bounds.x0 || bounds.y0 != other.bounds.y0 || bounds.x1 != other.bounds.x1 || bounds.y1 != other.bounds.y1)
+		return false;
+	if (items.size() != other.items.size())
+		return false;
+	for (size_t index = 0; index < items.size(); index++)
+	{
+		const item_key &a = items[index], &b = other.items[index];
+		if (a.state != b.state || a.orientation != b.orientation)
+			return false;
+		if (a.bounds.x0 != b.bounds.x0 || a.bounds.y0 != b.bounds.y0 || a.bounds.x1 != b.bounds.x1 || a.bounds.y1 != b.bounds.y1)
+			return false;
+		if (a.color.r != b.color.r || a.color.g != b.color.g || a.color.b != b.color.b || a.color.a != b.color.a)
+			return false;
+	}
+	return true;
+}
+
+
 //-------------------------------------------------
 //  map_point_internal - internal logic for
 //  mapping points
@@ -381,8 +381,15 @@ class render_primitive_list
 	~render_primitive_list();
 
 public:
+	// change flags, describing how this list differs from the one before it
+	static constexpr u32 CHANGED_GEOMETRY = 0x01;   // primitives were added, removed, moved or recoloured
+	static constexpr u32 CHANGED_TEXTURES = 0x02;   // a texture was replaced or its contents changed
+	static constexpr u32 CHANGED_ALL = CHANGED_GEOMETRY | CHANGED_TEXTURES;
+
 	// getters
 	render_primitive *first() const { return m_primlist.first(); }
+	u32 serial() const { return m_serial; }
+	u32 changes() const { return m_changes; }
 
 	// range iterators
 	using auto_iterator = simple_list<render_primitive>::auto_iterator;
@@ -403,6 +410,7 @@ private:
 	void release_all();
 	void append(render_primitive &prim) { append_or_return(prim, false); }
 	void append_or_return(render_primitive &prim, bool clipped);
+	void append_copy(const render_primitive_list &source);
 
 	// a reference is an abstract reference to an internal object of some sort
 	class reference
@@ -419,6 +427,10 @@ private:
 
 	fixed_allocator<render_primitive> m_primitive_allocator;// allocator for primitives
 	fixed_allocator<reference> m_reference_allocator;       // allocator for references
+	render_primitive_list * m_refcapture;                   // another list to add new references to
+
+	u32                     m_serial;                       // sequence number from the target
+	u32                     m_changes;                      // changes relative to the previous sequence number
 
 	std::recursive_mutex     m_lock;                             // lock to protect list accesses
 };
@@ -463,6 +475,7 @@ private:
 	// internal helpers
 	void get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo, render_primitive_list &primlist, u32 flags = 0);
 	const rgb_t *get_adjusted_palette(render_container &container);
+	void set_lookup_seq(u32 lookupseq);
 
 	static const int MAX_TEXTURE_SCALES = 16;
 
@@ -485,6 +498,8 @@ private:
 	texture_scaler_func m_scaler;                   // scaling callback
 	void *              m_param;                    // scaling callback parameter
 	u32              m_curseq;                   // current sequence number
+	u32              m_bitmapseq;                // sequence number of the unscaled bitmap
+	u32              m_lookupseq;                // container lookup sequence number it was last drawn with
 	scaled_texture      m_scaled[MAX_TEXTURE_SCALES];// array of scaled variants of this texture
 };
 
@@ -591,6 +606,7 @@ private:
 
 	// internal helpers
 	const simple_list<item> &items() const { return m_itemlist; }
+	u32 lookup_seq() const { return m_lookupseq; }
 	item &add_generic(u8 type, float x0, float y0, float x1, float y1, rgb_t argb);
 	void recompute_lookups();
 	void update_palette();
@@ -607,6 +623,7 @@ private:
 	std::unique_ptr<palette_client> m_palclient;    // client to the screen palette
 	std::vector<rgb_t>      m_bcglookup;            // copy of screen palette with bcg adjustment
 	rgb_t                   m_bcglookup256[0x400];  // lookup table for brightness/contrast/gamma
+	u32                     m_lookupseq;            // incremented whenever the lookup tables change
 };
 
 
@@ -1167,6 +1184,9 @@ private:
 	bool load_layout_file(const char *dirname, const internal_layout *layout_data);
 	void add_container_primitives(render_primitive_list &list, const object_transform &root_xform, const object_transform &xform, render_container &container, int blendmode);
 	void add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_element &element, int state, int blendmode);
+	void add_layer_primitives(render_primitive_list &list, const object_transform &root_xform, item_layer layer, int blendmode);
+	void add_item_primitives(render_primitive_list &list, const object_transform &root_xform, layout_view::item &curitem, int blendmode);
+	void update_primitive_changes(render_primitive_list &list);
 	bool map_point_internal(s32 target_x, s32 target_y, render_container *container, float &mapped_x, float &mapped_y, ioport_port *&mapped_input_port, ioport_value &mapped_input_mask);
 
 	// config callbacks
@@ -1187,6 +1207,32 @@ private:
 	static constexpr int NUM_PRIMLISTS = 3;
 	static constexpr int MAX_CLEAR_EXTENTS = 1000;
 
+	// a retained_layer holds the primitives for a layer of plain elements, along
+	// with everything they were generated from, so they can be reused until
+	// something in the layer changes
+	struct retained_layer
+	{
+		struct item_key
+		{
+			render_bounds   bounds;
+			render_color    color;
+			int             orientation;
+			int             state;
+		};
+
+		bool matches(const retained_layer &other) const;
+
+		bool                    valid = false;          // are the primitives usable?
+		layout_view *           view = nullptr;         // view the layer belongs to
+		int                     blendmode = 0;          // blend mode for the layer
+		float                   xoffs = 0, yoffs = 0;   // root transform
+		float                   xscale = 0, yscale = 0;
+		int                     orientation = 0;
+		s32                     maxtexwidth = 0, maxtexheight = 0;
+		render_bounds           bounds = { 0, 0, 0, 0 };// target bounds used for clipping
+		std::vector<item_key>   items;                  // per-item inputs
+	};
+
 	// internal state
 	render_target *         m_next;                     // link to next target
 	render_manager &        m_manager;                  // reference to our owning manager
@@ -1195,6 +1241,11 @@ private:
 	u32                     m_flags;                    // creation flags
 	render_primitive_list   m_primlist[NUM_PRIMLISTS];  // list of primitives
 	int                     m_listindex;                // index of next primlist to use
+	u32                     m_listserial;               // sequence number of the last list handed out
+	u64                     m_geometry_hash;            // hash of the last list's geometry
+	u64                     m_texture_hash;             // hash of the last list's textures
+	retained_layer          m_retained[ITEM_LAYER_MAX]; // inputs of retained layers
+	render_primitive_list   m_retained_primlist[ITEM_LAYER_MAX]; // primitives of retained layers
 	s32                     m_width;                    // width in pixels
 	s32                     m_height;                   // height in pixels
 	render_bounds           m_bounds;                   // bounds of the target
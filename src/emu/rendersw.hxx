@@ -14,6 +14,9 @@
 #include "video/rgbutil.h"
 #include "render.h"
 
+#include <algorithm>
+#include <exception>
+
 
 template<typename _PixelType, int _SrcShiftR, int _SrcShiftG, int _SrcShiftB, int _DstShiftR, int _DstShiftG, int _DstShiftB, bool _NoDestRead = false, bool _BilinearFilter = false>
 class software_renderer
@@ -28,6 +31,37 @@ private:
 		s32 endx, endy;
 	};
 
+	struct band_data
+	{
+		const render_primitive *first;
+		void *dstdata;
+		u32 width, height, pitch;
+		s32 top, bottom;
+		std::exception_ptr error;
+	};
+
+	struct cosine_table
+	{
+		cosine_table()
+		{
+			for (int index = 0; index <= 2048; index++)
+				entry[index] = int(double(1.0 / cos(atan(double(index) / 2048.0))) * 0x10000000 + 0.5);
+		}
+		u32 entry[2049];
+	};
+
+	// banding limits
+	static constexpr u32 MIN_BAND_HEIGHT = 16;
+	static constexpr u32 MAX_BANDS = 64;
+
+	// spans of 32bpp pixels in the standard format are drawn four at a time
+	// when the RGB utilities are SSE2-based
+#if defined(MAME_EMU_VIDEO_RGBSSE_H)
+	static constexpr bool SIMD_SPANS = (sizeof(_PixelType) == 4) && (_SrcShiftR == 0) && (_SrcShiftG == 0) && (_SrcShiftB == 0) && (_DstShiftR == 16) && (_DstShiftG == 8) && (_DstShiftB == 0);
+#else
+	static constexpr bool SIMD_SPANS = false;
+#endif
+
 	// internal helpers
 	static inline bool is_opaque(float alpha) { return (alpha >= (_NoDestRead ? 0.5f : 1.0f)); }
 	static inline bool is_transparent(float alpha) { return (alpha < (_NoDestRead ? 0.5f : 0.0001f)); }
@@ -123,6 +157,33 @@ private:
 	}
 
 
+	//-------------------------------------------------
+	//  get_corners_palette16 - fetch the four
+	//  palettized 16bpp texels around a sample point
+	//-------------------------------------------------
+
+	static inline void get_corners_palette16(const render_texinfo &texture, s32 curu, s32 curv, u32 &pix00, u32 &pix01, u32 &pix10, u32 &pix11)
+	{
+		const rgb_t *palbase = texture.palette;
+		s32 u0 = curu >> 16;
+		s32 u1 = 1;
+		if (u0 < 0) u0 = u1 = 0;
+		else if (u0 + 1 >= texture.width) u0 = texture.width - 1, u1 = 0;
+		s32 v0 = curv >> 16;
+		s32 v1 = texture.rowpixels;
+		if (v0 < 0) v0 = v1 = 0;
+		else if (v0 + 1 >= texture.height) v0 = texture.height - 1, v1 = 0;
+
+		const u16 *texbase = reinterpret_cast<const u16 *>(texture.base);
+		texbase += v0 * texture.rowpixels + u0;
+
+		pix00 = palbase[texbase[0]];
+		pix01 = palbase[texbase[u1]];
+		pix10 = palbase[texbase[v1]];
+		pix11 = palbase[texbase[u1 + v1]];
+	}
+
+
 	//-------------------------------------------------
 	//  get_texel_palette16 - return a texel from a
 	//  palettized 16bpp source
@@ -130,31 +191,16 @@ private:
 
 	static inline u32 get_texel_palette16(const render_texinfo &texture, s32 curu, s32 curv)
 	{
-		const rgb_t *palbase = texture.palette;
 		if (_BilinearFilter)
 		{
-			s32 u0 = curu >> 16;
-			s32 u1 = 1;
-			if (u0 < 0) u0 = u1 = 0;
-			else if (u0 + 1 >= texture.width) u0 = texture.width - 1, u1 = 0;
-			s32 v0 = curv >> 16;
-			s32 v1 = texture.rowpixels;
-			if (v0 < 0) v0 = v1 = 0;
-			else if (v0 + 1 >= texture.height) v0 = texture.height - 1, v1 = 0;
-
-			const u16 *texbase = reinterpret_cast<const u16 *>(texture.base);
-			texbase += v0 * texture.rowpixels + u0;
-
-			u32 pix00 = palbase[texbase[0]];
-			u32 pix01 = palbase[texbase[u1]];
-			u32 pix10 = palbase[texbase[v1]];
-			u32 pix11 = palbase[texbase[u1 + v1]];
+			u32 pix00, pix01, pix10, pix11;
+			get_corners_palette16(texture, curu, curv, pix00, pix01, pix10, pix11);
 			return rgbaint_t::bilinear_filter(pix00, pix01, pix10, pix11, curu >> 8, curv >> 8);
 		}
 		else
 		{
 			const u16 *texbase = reinterpret_cast<const u16 *>(texture.base) + (curv >> 16) * texture.rowpixels + (curu >> 16);
-			return palbase[texbase[0]];
+			return texture.palette[texbase[0]];
 		}
 	}
 
@@ -166,83 +212,83 @@ private:
 
 	static inline u32 get_texel_palette16a(const render_texinfo &texture, s32 curu, s32 curv)
 	{
-		const rgb_t *palbase = texture.palette;
 		if (_BilinearFilter)
 		{
-			s32 u0 = curu >> 16;
-			s32 u1 = 1;
-			if (u0 < 0) u0 = u1 = 0;
-			else if (u0 + 1 >= texture.width) u0 = texture.width - 1, u1 = 0;
-			s32 v0 = curv >> 16;
-			s32 v1 = texture.rowpixels;
-			if (v0 < 0) v0 = v1 = 0;
-			else if (v0 + 1 >= texture.height) v0 = texture.height - 1, v1 = 0;
-
-			const u16 *texbase = reinterpret_cast<const u16 *>(texture.base);
-			texbase += v0 * texture.rowpixels + u0;
-
-			return rgbaint_t::bilinear_filter(palbase[texbase[0]], palbase[texbase[u1]], palbase[texbase[v1]], palbase[texbase[u1 + v1]], curu >> 8, curv >> 8);
+			u32 pix00, pix01, pix10, pix11;
+			get_corners_palette16(texture, curu, curv, pix00, pix01, pix10, pix11);
+			return rgbaint_t::bilinear_filter(pix00, pix01, pix10, pix11, curu >> 8, curv >> 8);
 		}
 		else
 		{
 			const u16 *texbase = reinterpret_cast<const u16 *>(texture.base) + (curv >> 16) * texture.rowpixels + (curu >> 16);
-			return palbase[texbase[0]];
+			return texture.palette[texbase[0]];
 		}
 	}
 
 
 	//-------------------------------------------------
-	//  get_texel_yuy16 - return a texel from a 16bpp
-	//  YCbCr source (pixel is returned as Cr-Cb-Y)
+	//  get_corners_yuy16 - fetch the four 16bpp
+	//  YCbCr texels around a sample point
 	//-------------------------------------------------
 
-	static inline u32 get_texel_yuy16(const render_texinfo &texture, s32 curu, s32 curv)
+	static inline void get_corners_yuy16(const render_texinfo &texture, s32 curu, s32 curv, u32 &pix00, u32 &pix01, u32 &pix10, u32 &pix11)
 	{
-		if (_BilinearFilter)
+		s32 u0 = curu >> 16;
+		s32 u1 = 1;
+		if (u0 < 0) u0 = u1 = 0;
+		else if (u0 + 1 >= texture.width) u0 = texture.width - 1, u1 = 0;
+		s32 v0 = curv >> 16;
+		s32 v1 = texture.rowpixels;
+		if (v0 < 0) v0 = v1 = 0;
+		else if (v0 + 1 >= texture.height) v0 = texture.height - 1, v1 = 0;
+
+		const u16 *texbase = reinterpret_cast<const u16 *>(texture.base);
+		texbase += v0 * texture.rowpixels + (u0 & ~1);
+
+		if ((curu & 0x10000) == 0)
 		{
-			s32 u0 = curu >> 16;
-			s32 u1 = 1;
-			if (u0 < 0) u0 = u1 = 0;
-			else if (u0 + 1 >= texture.width) u0 = texture.width - 1, u1 = 0;
-			s32 v0 = curv >> 16;
-			s32 v1 = texture.rowpixels;
-			if (v0 < 0) v0 = v1 = 0;
-			else if (v0 + 1 >= texture.height) v0 = texture.height - 1, v1 = 0;
-
-			const u16 *texbase = reinterpret_cast<const u16 *>(texture.base);
-			texbase += v0 * texture.rowpixels + (u0 & ~1);
-
-			u32 pix00, pix01, pix10, pix11;
-			if ((curu & 0x10000) == 0)
+			u32 cbcr = ((texbase[0] & 0xff) << 8) | ((texbase[1] & 0xff) << 16);
+			pix00 = (texbase[0] >> 8) | cbcr;
+			pix01 = (texbase[u1] >> 8) | cbcr;
+			cbcr = ((texbase[v1 + 0] & 0xff) << 8) | ((texbase[v1 + 1] & 0xff) << 16);
+			pix10 = (texbase[v1 + 0] >> 8) | cbcr;
+			pix11 = (texbase[v1 + u1] >> 8) | cbcr;
+		}
+		else
+		{
+			u32 cbcr = ((texbase[0] & 0xff) << 8) | ((texbase[1] & 0xff) << 16);
+			pix00 = (texbase[1] >> 8) | cbcr;
+			if (u1 != 0)
 			{
-				u32 cbcr = ((texbase[0] & 0xff) << 8) | ((texbase[1] & 0xff) << 16);
-				pix00 = (texbase[0] >> 8) | cbcr;
-				pix01 = (texbase[u1] >> 8) | cbcr;
-				cbcr = ((texbase[v1 + 0] & 0xff) << 8) | ((texbase[v1 + 1] & 0xff) << 16);
-				pix10 = (texbase[v1 + 0] >> 8) | cbcr;
-				pix11 = (texbase[v1 + u1] >> 8) | cbcr;
+				cbcr = ((texbase[2] & 0xff) << 8) | ((texbase[3] & 0xff) << 16);
+				pix01 = (texbase[2] >> 8) | cbcr;
 			}
 			else
+				pix01 = pix00;
+			cbcr = ((texbase[v1 + 0] & 0xff) << 8) | ((texbase[v1 + 1] & 0xff) << 16);
+			pix10 = (texbase[v1 + 1] >> 8) | cbcr;
+			if (u1 != 0)
 			{
-				u32 cbcr = ((texbase[0] & 0xff) << 8) | ((texbase[1] & 0xff) << 16);
-				pix00 = (texbase[1] >> 8) | cbcr;
-				if (u1 != 0)
-				{
-					cbcr = ((texbase[2] & 0xff) << 8) | ((texbase[3] & 0xff) << 16);
-					pix01 = (texbase[2] >> 8) | cbcr;
-				}
-				else
-					pix01 = pix00;
-				cbcr = ((texbase[v1 + 0] & 0xff) << 8) | ((texbase[v1 + 1] & 0xff) << 16);
-				pix10 = (texbase[v1 + 1] >> 8) | cbcr;
-				if (u1 != 0)
-				{
-					cbcr = ((texbase[v1 + 2] & 0xff) << 8) | ((texbase[v1 + 3] & 0xff) << 16);
-					pix11 = (texbase[v1 + 2] >> 8) | cbcr;
-				}
-				else
-					pix11 = pix10;
+				cbcr = ((texbase[v1 + 2] & 0xff) << 8) | ((texbase[v1 + 3] & 0xff) << 16);
+				pix11 = (texbase[v1 + 2] >> 8) | cbcr;
 			}
+			else
+				pix11 = pix10;
+		}
+	}
+
+
+	//-------------------------------------------------
+	//  get_texel_yuy16 - return a texel from a 16bpp
+	//  YCbCr source (pixel is returned as Cr-Cb-Y)
+	//-------------------------------------------------
+
+	static inline u32 get_texel_yuy16(const render_texinfo &texture, s32 curu, s32 curv)
+	{
+		if (_BilinearFilter)
+		{
+			u32 pix00, pix01, pix10, pix11;
+			get_corners_yuy16(texture, curu, curv, pix00, pix01, pix10, pix11);
 			return rgbaint_t::bilinear_filter(pix00, pix01, pix10, pix11, curu >> 8, curv >> 8);
 		}
 		else
@@ -253,6 +299,32 @@ private:
 	}
 
 
+	//-------------------------------------------------
+	//  get_corners_rgb32 - fetch the four 32bpp
+	//  texels around a sample point
+	//-------------------------------------------------
+
+	static inline void get_corners_rgb32(const render_texinfo &texture, s32 curu, s32 curv, u32 &pix00, u32 &pix01, u32 &pix10, u32 &pix11)
+	{
+		s32 u0 = curu >> 16;
+		s32 u1 = 1;
+		if (u0 < 0) u0 = u1 = 0;
+		else if (u0 + 1 >= texture.width) u0 = texture.width - 1, u1 = 0;
+		s32 v0 = curv >> 16;
+		s32 v1 = texture.rowpixels;
+		if (v0 < 0) v0 = v1 = 0;
+		else if (v0 + 1 >= texture.height) v0 = texture.height - 1, v1 = 0;
+
+		const u32 *texbase = reinterpret_cast<const u32 *>(texture.base);
+		texbase += v0 * texture.rowpixels + u0;
+
+		pix00 = texbase[0];
+		pix01 = texbase[u1];
+		pix10 = texbase[v1];
+		pix11 = texbase[u1 + v1];
+	}
+
+
 	//-------------------------------------------------
 	//  get_texel_rgb32 - return a texel from a 32bpp
 	//  RGB source
@@ -262,19 +334,9 @@ private:
 	{
 		if (_BilinearFilter)
 		{
-			s32 u0 = curu >> 16;
-			s32 u1 = 1;
-			if (u0 < 0) u0 = u1 = 0;
-			else if (u0 + 1 >= texture.width) u0 = texture.width - 1, u1 = 0;
-			s32 v0 = curv >> 16;
-			s32 v1 = texture.rowpixels;
-			if (v0 < 0) v0 = v1 = 0;
-			else if (v0 + 1 >= texture.height) v0 = texture.height - 1, v1 = 0;
-
-			const u32 *texbase = reinterpret_cast<const u32 *>(texture.base);
-			texbase += v0 * texture.rowpixels + u0;
-
-			return rgbaint_t::bilinear_filter(texbase[0], texbase[u1], texbase[v1], texbase[u1 + v1], curu >> 8, curv >> 8);
+			u32 pix00, pix01, pix10, pix11;
+			get_corners_rgb32(texture, curu, curv, pix00, pix01, pix10, pix11);
+			return rgbaint_t::bilinear_filter(pix00, pix01, pix10, pix11, curu >> 8, curv >> 8);
 		}
 		else
 		{
@@ -293,19 +355,9 @@ private:
 	{
 		if (_BilinearFilter)
 		{
-			s32 u0 = curu >> 16;
-			s32 u1 = 1;
-			if (u0 < 0) u0 = u1 = 0;
-			else if (u0 + 1 >= texture.width) u0 = texture.width - 1, u1 = 0;
-			s32 v0 = curv >> 16;
-			s32 v1 = texture.rowpixels;
-			if (v0 < 0) v0 = v1 = 0;
-			else if (v0 + 1 >= texture.height) v0 = texture.height - 1, v1 = 0;
-
-			const u32 *texbase = reinterpret_cast<const u32 *>(texture.base);
-			texbase += v0 * texture.rowpixels + u0;
-
-			return rgbaint_t::bilinear_filter(texbase[0], texbase[u1], texbase[v1], texbase[u1 + v1], curu >> 8, curv >> 8);
+			u32 pix00, pix01, pix10, pix11;
+			get_corners_rgb32(texture, curu, curv, pix00, pix01, pix10, pix11);
+			return rgbaint_t::bilinear_filter(pix00, pix01, pix10, pix11, curu >> 8, curv >> 8);
 		}
 		else
 		{
@@ -315,6 +367,175 @@ private:
 	}
 
 
+#if defined(MAME_EMU_VIDEO_RGBSSE_H)
+	//-------------------------------------------------
+	//  bilinear_filter_unpacked - filter a texel
+	//  using the same arithmetic as
+	//  rgbaint_t::bilinear_filter, leaving the
+	//  channels unpacked so four pixels can be
+	//  packed together
+	//-------------------------------------------------
+
+	static inline __m128i bilinear_filter_unpacked(u32 rgb00, u32 rgb01, u32 rgb10, u32 rgb11, s32 curu, s32 curv)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const u32 u = u8(curu >> 8);
+		const u32 v = u8(curv >> 8);
+		const __m128i scaleu = _mm_set1_epi32(((0x100 - u) << 16) | u);
+		const __m128i scalev = _mm_set1_epi32(((0x100 - v) << 16) | v);
+
+		// interleave the left and right texels at the byte level
+		__m128i color01 = _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(rgb01), _mm_cvtsi32_si128(rgb00)), zero);
+		__m128i color11 = _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(rgb11), _mm_cvtsi32_si128(rgb10)), zero);
+		color01 = _mm_madd_epi16(color01, scaleu);
+		color11 = _mm_madd_epi16(color11, scaleu);
+		color01 = _mm_slli_epi32(color01, 15);
+		color11 = _mm_srli_epi32(color11, 1);
+		color01 = _mm_max_epi16(color01, color11);
+		color01 = _mm_madd_epi16(color01, scalev);
+		return _mm_srli_epi32(color01, 15);
+	}
+
+
+	//-------------------------------------------------
+	//  get_texels4 - fetch the next four texels of a
+	//  span
+	//-------------------------------------------------
+
+	template <u32 (*GetTexel)(const render_texinfo &, s32, s32), void (*GetCorners)(const render_texinfo &, s32, s32, u32 &, u32 &, u32 &, u32 &)>
+	static inline __m128i get_texels4(const render_texinfo &texture, s32 curu, s32 curv, s32 dudx, s32 dvdx)
+	{
+		if (_BilinearFilter)
+		{
+			__m128i result[4];
+			for (int index = 0; index < 4; index++)
+			{
+				u32 pix00, pix01, pix10, pix11;
+				GetCorners(texture, curu, curv, pix00, pix01, pix10, pix11);
+				result[index] = bilinear_filter_unpacked(pix00, pix01, pix10, pix11, curu, curv);
+				curu += dudx;
+				curv += dvdx;
+			}
+			return _mm_packus_epi16(_mm_packs_epi32(result[0], result[1]), _mm_packs_epi32(result[2], result[3]));
+		}
+		else
+		{
+			const u32 pix0 = GetTexel(texture, curu, curv);
+			const u32 pix1 = GetTexel(texture, curu + dudx, curv + dvdx);
+			const u32 pix2 = GetTexel(texture, curu + 2 * dudx, curv + 2 * dvdx);
+			const u32 pix3 = GetTexel(texture, curu + 3 * dudx, curv + 3 * dvdx);
+			return _mm_set_epi32(pix3, pix2, pix1, pix0);
+		}
+	}
+
+	static inline __m128i get_texels4_rgb32(const render_texinfo &texture, s32 curu, s32 curv, s32 dudx, s32 dvdx)
+	{
+		// unscaled point samples are contiguous in the source
+		if (!_BilinearFilter && dudx == 0x10000 && dvdx == 0)
+			return _mm_loadu_si128(reinterpret_cast<const __m128i *>(reinterpret_cast<const u32 *>(texture.base) + (curv >> 16) * texture.rowpixels + (curu >> 16)));
+		return get_texels4<get_texel_rgb32, get_corners_rgb32>(texture, curu, curv, dudx, dvdx);
+	}
+
+
+	//-------------------------------------------------
+	//  ycc_to_rgb4 - convert four YCC pixels to RGB
+	//  using the same arithmetic as ycc_to_rgb
+	//-------------------------------------------------
+
+	static inline __m128i ycc_to_rgb4(__m128i ycc)
+	{
+		const __m128i bytemask = _mm_set1_epi32(0xff);
+		const __m128i y = _mm_and_si128(ycc, bytemask);
+		const __m128i cb = _mm_and_si128(_mm_srli_epi32(ycc, 8), bytemask);
+		const __m128i cr = _mm_and_si128(_mm_srli_epi32(ycc, 16), bytemask);
+		const __m128i ycb = _mm_or_si128(y, _mm_slli_epi32(cb, 16));
+		const __m128i ycr = _mm_or_si128(y, _mm_slli_epi32(cr, 16));
+
+		__m128i r = _mm_madd_epi16(ycr, _mm_set_epi16(409, 298, 409, 298, 409, 298, 409, 298));
+		__m128i g = _mm_madd_epi16(ycb, _mm_set_epi16(-100, 298, -100, 298, -100, 298, -100, 298));
+		__m128i b = _mm_madd_epi16(ycb, _mm_set_epi16(516, 298, 516, 298, 516, 298, 516, 298));
+		g = _mm_add_epi32(g, _mm_madd_epi16(cr, _mm_set_epi16(0, -208, 0, -208, 0, -208, 0, -208)));
+		r = _mm_srai_epi32(_mm_add_epi32(r, _mm_set1_epi32(-56992)), 8);
+		g = _mm_srai_epi32(_mm_add_epi32(g, _mm_set1_epi32(34784)), 8);
+		b = _mm_srai_epi32(_mm_add_epi32(b, _mm_set1_epi32(-70688)), 8);
+
+		// saturating packs clamp to 0-255 like clamp16_shift8; then transpose to B,G,R,A order
+		const __m128i planes = _mm_packus_epi16(_mm_packs_epi32(b, g), _mm_packs_epi32(r, bytemask));
+		const __m128i pairs = _mm_unpacklo_epi8(planes, _mm_srli_si128(planes, 8));
+		return _mm_unpacklo_epi8(pairs, _mm_srli_si128(pairs, 8));
+	}
+#endif
+
+
+	//-------------------------------------------------
+	//  draw_span_* - draw as much of a span as can be
+	//  done four pixels at a time, advancing the
+	//  destination and texture coordinates past the
+	//  pixels drawn; return the number of pixels
+	//  drawn, which is always 0 unless SIMD_SPANS
+	//-------------------------------------------------
+
+	static inline s32 draw_span_palette16(const render_texinfo &texture, _PixelType *&dest, s32 count, s32 &curu, s32 &curv, s32 dudx, s32 dvdx)
+	{
+		s32 x = 0;
+#if defined(MAME_EMU_VIDEO_RGBSSE_H)
+		for ( ; x + 4 <= count; x += 4, dest += 4, curu += 4 * dudx, curv += 4 * dvdx)
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), get_texels4<get_texel_palette16, get_corners_palette16>(texture, curu, curv, dudx, dvdx));
+#endif
+		return x;
+	}
+
+	static inline s32 draw_span_yuy16(const render_texinfo &texture, _PixelType *&dest, s32 count, s32 &curu, s32 &curv, s32 dudx, s32 dvdx)
+	{
+		s32 x = 0;
+#if defined(MAME_EMU_VIDEO_RGBSSE_H)
+		for ( ; x + 4 <= count; x += 4, dest += 4, curu += 4 * dudx, curv += 4 * dvdx)
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), ycc_to_rgb4(get_texels4<get_texel_yuy16, get_corners_yuy16>(texture, curu, curv, dudx, dvdx)));
+#endif
+		return x;
+	}
+
+	static inline s32 draw_span_rgb32(const render_texinfo &texture, _PixelType *&dest, s32 count, s32 &curu, s32 &curv, s32 dudx, s32 dvdx)
+	{
+		s32 x = 0;
+#if defined(MAME_EMU_VIDEO_RGBSSE_H)
+		for ( ; x + 4 <= count; x += 4, dest += 4, curu += 4 * dudx, curv += 4 * dvdx)
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), get_texels4_rgb32(texture, curu, curv, dudx, dvdx));
+#endif
+		return x;
+	}
+
+	static inline s32 draw_span_argb32_alpha(const render_texinfo &texture, _PixelType *&dest, s32 count, s32 &curu, s32 &curv, s32 dudx, s32 dvdx)
+	{
+		s32 x = 0;
+#if defined(MAME_EMU_VIDEO_RGBSSE_H)
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i alphamask = _mm_set1_epi32(0xff000000);
+		const __m128i one = _mm_set1_epi16(0x100);
+		for ( ; x + 4 <= count; x += 4, dest += 4, curu += 4 * dudx, curv += 4 * dvdx)
+		{
+			const __m128i pix = get_texels4_rgb32(texture, curu, curv, dudx, dvdx);
+			const __m128i dpix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest));
+			const __m128i blenddpix = _NoDestRead ? zero : dpix;
+
+			// blend each pixel by its texel's alpha, two pixels per register
+			const __m128i srclo = _mm_unpacklo_epi8(pix, zero);
+			const __m128i srchi = _mm_unpackhi_epi8(pix, zero);
+			const __m128i talo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srclo, 0xff), 0xff);
+			const __m128i tahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(srchi, 0xff), 0xff);
+			const __m128i reslo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(srclo, talo), _mm_mullo_epi16(_mm_unpacklo_epi8(blenddpix, zero), _mm_sub_epi16(one, talo))), 8);
+			const __m128i reshi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(srchi, tahi), _mm_mullo_epi16(_mm_unpackhi_epi8(blenddpix, zero), _mm_sub_epi16(one, tahi))), 8);
+			const __m128i result = _mm_andnot_si128(alphamask, _mm_packus_epi16(reslo, reshi));
+
+			// fully transparent texels leave the destination alone
+			const __m128i keep = _mm_cmpeq_epi32(_mm_and_si128(pix, alphamask), zero);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_or_si128(_mm_and_si128(keep, dpix), _mm_andnot_si128(keep, result)));
+		}
+#endif
+		return x;
+	}
+
+
 	//-------------------------------------------------
 	//  draw_aa_pixel - draw an antialiased pixel
 	//-------------------------------------------------
@@ -337,11 +558,8 @@ private:
 	//  draw_line - draw a line or point
 	//-------------------------------------------------
 
-	static void draw_line(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_line(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 bandtop, s32 bandbottom, u32 pitch)
 	{
-		// internal tables
-		static u32 s_cosine_table[2049];
-
 		// compute the start/end coordinates
 		int x1 = int(prim.bounds.x0 * 65536.0f);
 		int y1 = int(prim.bounds.y0 * 65536.0f);
@@ -353,10 +571,8 @@ private:
 
 		if (PRIMFLAG_GET_ANTIALIAS(prim.flags))
 		{
-			// build up the cosine table if we haven't yet
-			if (s_cosine_table[0] == 0)
-				for (int entry = 0; entry <= 2048; entry++)
-					s_cosine_table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+			// build up the cosine table if we haven't yet; bands may get here concurrently
+			static const cosine_table s_cosine_table;
 
 			int beam = prim.width * 65536.0f;
 			if (beam < 0x00010000)
@@ -374,7 +590,7 @@ private:
 					dy--;
 				x1 >>= 16;
 				int xx = x2 >> 16;
-				int bwidth = mul_32x32_hi(beam << 4, s_cosine_table[abs(sy) >> 5]);
+				int bwidth = mul_32x32_hi(beam << 4, s_cosine_table.entry[abs(sy) >> 5]);
 				y1 -= bwidth >> 1; // start back half the diameter
 				for (;;)
 				{
@@ -382,7 +598,7 @@ private:
 					{
 						dx = bwidth;    // init diameter of beam
 						dy = y1 >> 16;
-						if (dy >= 0 && dy < height)
+						if (dy >= bandtop && dy < bandbottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(0xff & (~y1 >> 8), col));
 						dy++;
 						dx -= 0x10000 - (0xffff & y1); // take off amount plotted
@@ -390,11 +606,11 @@ private:
 						dx >>= 16;                   // adjust to pixel (solid) count
 						while (dx--)                 // plot rest of pixels
 						{
-							if (dy >= 0 && dy < height)
+							if (dy >= bandtop && dy < bandbottom)
 								draw_aa_pixel(dstdata, pitch, x1, dy, col);
 							dy++;
 						}
-						if (dy >= 0 && dy < height)
+						if (dy >= bandtop && dy < bandbottom)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(a1,col));
 					}
 					if (x1 == xx) break;
@@ -410,11 +626,11 @@ private:
 					dx--;
 				y1 >>= 16;
 				int yy = y2 >> 16;
-				int bwidth = mul_32x32_hi(beam << 4,s_cosine_table[abs(sx) >> 5]);
+				int bwidth = mul_32x32_hi(beam << 4,s_cosine_table.entry[abs(sx) >> 5]);
 				x1 -= bwidth >> 1; // start back half the width
 				for (;;)
 				{
-					if (y1 >= 0 && y1 < height)
+					if (y1 >= bandtop && y1 < bandbottom)
 					{
 						dy = bwidth;    // calc diameter of beam
 						dx = x1 >> 16;
@@ -457,7 +673,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= bandtop && y1 < bandbottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (x1 == x2) break;
 					x1 += sx;
@@ -473,7 +689,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= bandtop && y1 < bandbottom)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (y1 == y2) break;
 					y1 += sy;
@@ -498,7 +714,7 @@ private:
 	//  draw_rect - draw a solid rectangle
 	//-------------------------------------------------
 
-	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch, s32 bandtop, s32 bandbottom)
 	{
 		render_bounds fpos = prim.bounds;
 		assert(fpos.x0 <= fpos.x1);
@@ -520,6 +736,10 @@ private:
 		if (endy < 0) endy = 0;
 		if (endy >= height) endy = height;
 
+		// limit to the band being drawn
+		if (starty < bandtop) starty = bandtop;
+		if (endy > bandbottom) endy = bandbottom;
+
 		// bail if nothing left
 		if (fpos.x0 > fpos.x1 || fpos.y0 > fpos.y1)
 			return;
@@ -622,8 +842,11 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
-				// loop over cols
-				for (s32 x = setup.startx; x < endx; x++)
+				// loop over cols, four at a time where possible
+				s32 x = setup.startx;
+				if (SIMD_SPANS)
+					x += draw_span_palette16(prim.texture, dest, endx - x, curu, curv, dudx, dvdx);
+				for ( ; x < endx; x++)
 				{
 					u32 pix = get_texel_palette16(prim.texture, curu, curv);
 					*dest++ = source32_to_dest(pix);
@@ -916,8 +1139,11 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
-				// loop over cols
-				for (s32 x = setup.startx; x < endx; x++)
+				// loop over cols, four at a time where possible
+				s32 x = setup.startx;
+				if (SIMD_SPANS)
+					x += draw_span_yuy16(prim.texture, dest, endx - x, curu, curv, dudx, dvdx);
+				for ( ; x < endx; x++)
 				{
 					u32 pix = ycc_to_rgb(get_texel_yuy16(prim.texture, curu, curv));
 					*dest++ = source32_to_dest(pix);
@@ -1114,8 +1340,11 @@ private:
 				// no lookup case
 				if (palbase == nullptr)
 				{
-					// loop over cols
-					for (s32 x = setup.startx; x < endx; x++)
+					// loop over cols, four at a time where possible
+					s32 x = setup.startx;
+					if (SIMD_SPANS)
+						x += draw_span_rgb32(prim.texture, dest, endx - x, curu, curv, dudx, dvdx);
+					for ( ; x < endx; x++)
 					{
 						u32 pix = get_texel_rgb32(prim.texture, curu, curv);
 						*dest++ = source32_to_dest(pix);
@@ -1422,8 +1651,11 @@ private:
 				// no lookup case
 				if (palbase == nullptr)
 				{
-					// loop over cols
-					for (s32 x = setup.startx; x < endx; x++)
+					// loop over cols, four at a time where possible
+					s32 x = setup.startx;
+					if (SIMD_SPANS)
+						x += draw_span_argb32_alpha(prim.texture, dest, endx - x, curu, curv, dudx, dvdx);
+					for ( ; x < endx; x++)
 					{
 						u32 pix = get_texel_argb32(prim.texture, curu, curv);
 						u32 ta = pix >> 24;
@@ -1825,7 +2057,7 @@ private:
 	//  drawing routine
 	//-------------------------------------------------
 
-	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch)
+	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, s32 width, s32 height, u32 pitch, s32 bandtop, s32 bandbottom)
 	{
 		assert(prim.bounds.x0 <= prim.bounds.x1);
 		assert(prim.bounds.y0 <= prim.bounds.y1);
@@ -1872,6 +2104,18 @@ private:
 			setup.startv -= 0x8000;
 		}
 
+		// limit to the band being drawn, stepping U/V exactly as the rows above would have
+		if (setup.starty < bandtop)
+		{
+			setup.startu += (bandtop - setup.starty) * setup.dudy;
+			setup.startv += (bandtop - setup.starty) * setup.dvdy;
+			setup.starty = bandtop;
+		}
+		if (setup.endy > bandbottom)
+			setup.endy = bandbottom;
+		if (setup.starty >= setup.endy)
+			return;
+
 		// render based on the texture coordinates
 		switch (prim.flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 		{
@@ -1931,30 +2175,110 @@ private:
 	//**************************************************************************
 
 	//-------------------------------------------------
-	//  draw_primitives - draw a series of primitives
-	//  using a software rasterizer
+	//  draw_band - draw the part of a series of
+	//  primitives that falls within a range of rows
 	//-------------------------------------------------
 
-public:
-	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
+	static void draw_band(const render_primitive *first, void *dstdata, u32 width, u32 height, u32 pitch, s32 bandtop, s32 bandbottom)
 	{
 		// loop over the list and render each element
-		for (const render_primitive *prim = primlist.first(); prim != nullptr; prim = prim->next())
+		for (const render_primitive *prim = first; prim != nullptr; prim = prim->next())
 			switch (prim->type)
 			{
 				case render_primitive::LINE:
-					draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+					draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, bandtop, bandbottom, pitch);
 					break;
 
 				case render_primitive::QUAD:
+					// skip quads that can't touch this band
+					if (s32(round_nearest(prim->bounds.y1)) <= bandtop || s32(round_nearest(prim->bounds.y0)) >= bandbottom)
+						break;
 					if (!prim->texture.base)
-						draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch, bandtop, bandbottom);
 					else
-						setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch, bandtop, bandbottom);
 					break;
 
 				default:
 					throw emu_fatalerror("Unexpected render_primitive type");
 			}
 	}
+
+	//-------------------------------------------------
+	//  draw_band_callback - work queue callback for
+	//  draw_band
+	//-------------------------------------------------
+
+	static void *draw_band_callback(void *param, int threadid)
+	{
+		band_data &band = *reinterpret_cast<band_data *>(param);
+		try
+		{
+			draw_band(band.first, band.dstdata, band.width, band.height, band.pitch, band.top, band.bottom);
+		}
+		catch (...)
+		{
+			band.error = std::current_exception();
+		}
+		return nullptr;
+	}
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives
+	//  using a software rasterizer
+	//-------------------------------------------------
+
+public:
+	static void draw_primitives(const render_primitive *first, void *dstdata, u32 width, u32 height, u32 pitch)
+	{
+		draw_band(first, dstdata, width, height, pitch, 0, height);
+	}
+
+	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, u32 width, u32 height, u32 pitch)
+	{
+		draw_primitives(primlist.first(), dstdata, width, height, pitch);
+	}
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives
+	//  in horizontal bands on a work queue; the
+	//  result is identical to drawing in one pass
+	//-------------------------------------------------
+
+	static void draw_primitives(const render_primitive *first, void *dstdata, u32 width, u32 height, u32 pitch, osd_work_queue *queue, u32 bands)
+	{
+		// don't bother splitting small targets
+		bands = std::min(std::min(bands, height / MIN_BAND_HEIGHT), MAX_BANDS);
+		if (queue == nullptr || bands < 2)
+		{
+			draw_primitives(first, dstdata, width, height, pitch);
+			return;
+		}
+
+		band_data band[MAX_BANDS];
+		for (u32 index = 0; index < bands; index++)
+		{
+			band[index].first = first;
+			band[index].dstdata = dstdata;
+			band[index].width = width;
+			band[index].height = height;
+			band[index].pitch = pitch;
+			band[index].top = u64(height) * index / bands;
+			band[index].bottom = u64(height) * (index + 1) / bands;
+		}
+
+		// the calling thread helps out while it waits
+		osd_work_item_queue_multiple(queue, draw_band_callback, bands, band, sizeof(band[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+
+		// report errors the same way as a single pass would
+		for (u32 index = 0; index < bands; index++)
+			if (band[index].error)
+				std::rethrow_exception(band[index].error);
+	}
+
+	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, u32 width, u32 height, u32 pitch, osd_work_queue *queue, u32 bands)
+	{
+		draw_primitives(primlist.first(), dstdata, width, height, pitch, queue, bands);
+	}
 };
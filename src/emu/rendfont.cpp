@@ -369,6 +369,21 @@ private:
 	u8                              *m_ptr;
 };
 
+
+//-------------------------------------------------
+//  string_hash - FNV-1a hash of a run of bytes,
+//  used to key measured strings without copying
+//  them
+//-------------------------------------------------
+
+inline u64 string_hash(u64 seed, const char *string, std::size_t length)
+{
+	u64 hash(0xcbf29ce484222325U ^ seed);
+	for (std::size_t i = 0U; length > i; ++i)
+		hash = (hash ^ u8(string[i])) * 0x100000001b3U;
+	return hash;
+}
+
 } // anonymous namespace
 
 
@@ -445,6 +460,9 @@ void convert_command_glyph(std::string &str)
 
 
 const u64 render_font::CACHED_BDF_HASH_SIZE;
+const s32 render_font_atlas::FIRST_PAGE_SIZE;
+const s32 render_font_atlas::PAGE_SIZE;
+const size_t render_font::STRING_WIDTH_CACHE_SIZE;
 
 //**************************************************************************
 //  INLINE FUNCTIONS
@@ -523,16 +541,12 @@ inline render_font::glyph &render_font::get_char(char32_t chnum)
 			gl.bmwidth = int(glyph_ch.bmwidth * scale + 0.5f);
 			gl.bmheight = int(glyph_ch.bmheight * scale + 0.5f);
 
-			gl.bitmap.allocate(gl.bmwidth, gl.bmheight);
+			m_atlas.allocate(gl.bitmap, gl.bmwidth, gl.bmheight);
 			rectangle clip;
 			clip.min_x = clip.min_y = 0;
 			clip.max_x = glyph_ch.bitmap.width() - 1;
 			clip.max_y = glyph_ch.bitmap.height() - 1;
 			render_texture::hq_scale(gl.bitmap, glyph_ch.bitmap, clip, nullptr);
-
-			/* wrap a texture around the bitmap */
-			gl.texture = m_manager.texture_alloc(render_texture::hq_scale);
-			gl.texture->set_bitmap(gl.bitmap, gl.bitmap.cliprect(), TEXFORMAT_ARGB32);
 		}
 		else
 		{
@@ -545,6 +559,64 @@ inline render_font::glyph &render_font::get_char(char32_t chnum)
 
 
 
+//**************************************************************************
+//  RENDER FONT ATLAS
+//**************************************************************************
+
+//-------------------------------------------------
+//  render_font_atlas - constructor
+//-------------------------------------------------
+
+render_font_atlas::render_font_atlas()
+	: m_x(0)
+	, m_y(0)
+	, m_shelf(0)
+{
+}
+
+
+//-------------------------------------------------
+//  allocate - point a bitmap at free space on a
+//  page, starting a new shelf or page as needed;
+//  pages start small and each new one is twice
+//  the size of the last, so fonts that only use
+//  a few glyphs stay cheap, and glyphs are left a
+//  pixel apart so the scaler doesn't pick up
+//  their neighbours
+//-------------------------------------------------
+
+void render_font_atlas::allocate(bitmap_argb32 &dest, s32 width, s32 height)
+{
+	if (width <= 0 || height <= 0)
+	{
+		dest.reset();
+		return;
+	}
+
+	// move to the next shelf or page if it doesn't fit; a glyph wider than
+	// the page gets a page of its own
+	if (m_pages.empty() || (m_x + width) > m_pages.back()->width())
+	{
+		m_x = 0;
+		m_y += m_shelf;
+		m_shelf = 0;
+	}
+	if (m_pages.empty() || (width + 1) > m_pages.back()->width() || (m_y + height) > m_pages.back()->height())
+	{
+		s32 const size = m_pages.empty() ? FIRST_PAGE_SIZE : std::min(m_pages.back()->width() * 2, PAGE_SIZE);
+		m_pages.emplace_back(std::make_unique<bitmap_argb32>(std::max(size, width + 1), std::max(size, height + 1)));
+		m_pages.back()->fill(0);
+		m_x = m_y = m_shelf = 0;
+	}
+
+	bitmap_argb32 &page = *m_pages.back();
+	dest.wrap(&page.pix32(m_y, m_x), width, height, page.rowpixels());
+	m_x += width + 1;
+	m_shelf = std::max(m_shelf, height + 1);
+}
+
+
+
 //**************************************************************************
 //  RENDER FONT
 //**************************************************************************
@@ -655,8 +727,8 @@ void render_font::char_expand(char32_t chnum, glyph &gl)
 		if (gl.bmwidth == 0 || gl.bmheight == 0 || gl.rawdata == nullptr)
 			return;
 
-		// allocate a new bitmap of the size we need
-		gl.bitmap.allocate(gl.bmwidth, m_height_cmd);
+		// allocate space of the size we need
+		m_atlas.allocate(gl.bitmap, gl.bmwidth, m_height_cmd);
 		gl.bitmap.fill(0);
 
 		// extract the data
@@ -687,7 +759,8 @@ void render_font::char_expand(char32_t chnum, glyph &gl)
 			LOG("render_font::char_expand: previously failed to get bitmap from OSD font\n");
 			return;
 		}
-		if (!m_osdfont->get_bitmap(chnum, gl.bitmap, gl.width, gl.xoffs, gl.yoffs))
+		bitmap_argb32 osdbitmap;
+		if (!m_osdfont->get_bitmap(chnum, osdbitmap, gl.width, gl.xoffs, gl.yoffs))
 		{
 			// attempt to get the font bitmap failed - set bmwidth to -1
 			LOG("render_font::char_expand: get bitmap from OSD font failed\n");
@@ -697,10 +770,13 @@ void render_font::char_expand(char32_t chnum, glyph &gl)
 		}
 		else
 		{
-			// populate the bmwidth/bmheight fields
-			LOG("render_font::char_expand: got %dx%d bitmap from OSD font\n", gl.bitmap.width(), gl.bitmap.height());
-			gl.bmwidth = gl.bitmap.width();
-			gl.bmheight = gl.bitmap.height();
+			// populate the bmwidth/bmheight fields and move it to the atlas
+			LOG("render_font::char_expand: got %dx%d bitmap from OSD font\n", osdbitmap.width(), osdbitmap.height());
+			gl.bmwidth = osdbitmap.width();
+			gl.bmheight = osdbitmap.height();
+			m_atlas.allocate(gl.bitmap, gl.bmwidth, gl.bmheight);
+			for (int y = 0; y < gl.bmheight; y++)
+				std::copy_n(&osdbitmap.pix32(y), gl.bmwidth, &gl.bitmap.pix32(y));
 		}
 	}
 	else if (!gl.bmwidth || !gl.bmheight || !gl.rawdata)
@@ -714,8 +790,8 @@ void render_font::char_expand(char32_t chnum, glyph &gl)
 		// other formats need to parse their data
 		LOG("render_font::char_expand: building bitmap from raw data\n");
 
-		// allocate a new bitmap of the size we need
-		gl.bitmap.allocate(gl.bmwidth, m_height);
+		// allocate space of the size we need
+		m_atlas.allocate(gl.bitmap, gl.bmwidth, m_height);
 		gl.bitmap.fill(0);
 
 		// extract the data
@@ -774,10 +850,6 @@ void render_font::char_expand(char32_t chnum, glyph &gl)
 			}
 		}
 	}
-
-	// wrap a texture around the bitmap
-	gl.texture = m_manager.texture_alloc(render_texture::hq_scale);
-	gl.texture->set_bitmap(gl.bitmap, gl.bitmap.cliprect(), TEXFORMAT_ARGB32);
 }
 
 
@@ -800,7 +872,13 @@ render_texture *render_font::get_char_texture_and_bounds(float height, float asp
 	bounds.x1 = bounds.x0 + float(gl.bmwidth) * scale * aspect;
 	bounds.y1 = bounds.y0 + float(m_height) * scale;
 
-	// return the texture
+	// glyphs that are only measured never need a texture, so wrap one
+	// around the bitmap the first time the glyph is drawn
+	if (gl.texture == nullptr && gl.bitmap.valid())
+	{
+		gl.texture = m_manager.texture_alloc(render_texture::hq_scale);
+		gl.texture->set_bitmap(gl.bitmap, gl.bitmap.cliprect(), TEXFORMAT_ARGB32);
+	}
 	return gl.texture;
 }
 
@@ -828,8 +906,8 @@ void render_font::get_scaled_bitmap_and_bounds(bitmap_argb32 &dest, float height
 	if (dest.width() < bounds.width() || dest.height() < bounds.height())
 		return;
 
-	// if no texture, fill the target
-	if (gl.texture == nullptr)
+	// if no bitmap, fill the target
+	if (!gl.bitmap.valid())
 	{
 		dest.fill(0);
 		return;
@@ -859,10 +937,17 @@ float render_font::char_width(float height, float aspect, char32_t ch)
 
 float render_font::string_width(float height, float aspect, const char *string)
 {
+	const char *ends = string + strlen(string);
+
+	// the UI measures the same strings every frame
+	u64 const key = string_hash(0, string, ends - string);
+	auto const found = m_string_widths.find(key);
+	if (found != m_string_widths.end())
+		return float(found->second) * m_scale * height * aspect;
+
 	// loop over the string and accumulate widths
 	int totwidth = 0;
 
-	const char *ends = string + strlen(string);
 	const char *s = string;
 	char32_t schar;
 
@@ -873,7 +958,7 @@ float render_font::string_width(float height, float aspect, const char *string)
 		totwidth += get_char(schar).width;
 		s += scharcount;
 	}
-
+	cache_string_width(key, totwidth);
 
 	// scale the final result based on height
 	return float(totwidth) * m_scale * height * aspect;
@@ -889,6 +974,12 @@ float render_font::utf8string_width(float height, float aspect, const char *utf8
 {
 	std::size_t const length = std::strlen(utf8string);
 
+	// this stops at the first invalid character, so it's keyed separately
+	u64 const key = string_hash(1, utf8string, length);
+	auto const found = m_string_widths.find(key);
+	if (found != m_string_widths.end())
+		return float(found->second) * m_scale * height * aspect;
+
 	// loop over the string and accumulate widths
 	int count;
 	s32 totwidth = 0;
@@ -901,12 +992,28 @@ float render_font::utf8string_width(float height, float aspect, const char *utf8
 
 		totwidth += get_char(uchar).width;
 	}
+	cache_string_width(key, totwidth);
 
 	// scale the final result based on height
 	return float(totwidth) * m_scale * height * aspect;
 }
 
 
+//-------------------------------------------------
+//  cache_string_width - remember the width of a
+//  string in font units, which holds for every
+//  height and aspect
+//-------------------------------------------------
+
+void render_font::cache_string_width(u64 key, s32 width)
+{
+	// start over rather than grow without bound
+	if (m_string_widths.size() >= STRING_WIDTH_CACHE_SIZE)
+		m_string_widths.clear();
+	m_string_widths.emplace(key, width);
+}
+
+
 //-------------------------------------------------
 //  load_cached_bdf - attempt to load a cached
 //  version of the BDF font 'filename'; if that
@@ -1480,6 +1587,29 @@ bool render_font::save_cached(const char *filename, u64 length, u32 hash)
 	}
 	LOG("render_font::save_cached: %u glyphs with positive advance to save\n", numchars);
 
+	// expand glyphs into scratch atlas pages so caching a large font doesn't
+	// leave every glyph's pixels allocated for the life of the font
+	render_font_atlas atlas;
+	std::swap(atlas, m_atlas);
+	auto const release_scratch_atlas =
+		[this, &atlas] ()
+		{
+			// glyphs that were written out have already let go of their bitmaps
+			for (glyph *const page : m_glyphs)
+			{
+				for (unsigned chnum = 0; page && (256 > chnum); ++chnum)
+				{
+					if ((0 < page[chnum].width) && page[chnum].bitmap.valid())
+					{
+						m_manager.texture_free(page[chnum].texture);
+						page[chnum].bitmap.reset();
+						page[chnum].texture = nullptr;
+					}
+				}
+			}
+			std::swap(atlas, m_atlas);
+		};
+
 	try
 	{
 		u32 bytes_written;
@@ -1590,10 +1720,12 @@ bool render_font::save_cached(const char *filename, u64 length, u32 hash)
 		}
 
 		// no trouble?
+		release_scratch_atlas();
 		return true;
 	}
 	catch (...)
 	{
+		release_scratch_atlas();
 		file.remove_on_close();
 		return false;
 	}
@@ -13,6 +13,8 @@
 
 #include "render.h"
 
+#include <unordered_map>
+
 // forward instead of include
 class osd_font;
 
@@ -21,6 +23,33 @@ class osd_font;
 //**************************************************************************
 
 
+// ======================> render_font_atlas
+
+// packs expanded glyphs into shelves on shared bitmap pages
+class render_font_atlas
+{
+public:
+	render_font_atlas();
+
+	// point a bitmap at free space, adding a page if needed
+	void allocate(bitmap_argb32 &dest, s32 width, s32 height);
+
+	// getters
+	std::size_t page_count() const { return m_pages.size(); }
+	bitmap_argb32 const &page(std::size_t index) const { return *m_pages[index]; }
+
+	// constants
+	static const s32 FIRST_PAGE_SIZE    = 128;
+	static const s32 PAGE_SIZE          = 1024;
+
+private:
+	std::vector<std::unique_ptr<bitmap_argb32>> m_pages; // atlas pages
+	s32                 m_x;                // next free column on the current shelf
+	s32                 m_y;                // top of the current shelf
+	s32                 m_shelf;            // height of the current shelf
+};
+
+
 // ======================> render_font
 
 // a render_font describes and provides an interface to a font
@@ -67,7 +96,7 @@ private:
 		s32                 bmwidth, bmheight;  // width and height of bitmap
 		const char *        rawdata;            // pointer to the raw data for this one
 		render_texture *    texture;            // pointer to a texture for rendering and sizing
-		bitmap_argb32       bitmap;             // pointer to the bitmap containing the raw data
+		bitmap_argb32       bitmap;             // expanded glyph, wrapping part of an atlas page
 
 		rgb_t               color;
 	};
@@ -90,6 +119,7 @@ private:
 	bool save_cached(const char *filename, u64 length, u32 hash);
 
 	void render_font_command_glyph();
+	void cache_string_width(u64 key, s32 width);
 
 	// internal state
 	render_manager &    m_manager;
@@ -108,8 +138,14 @@ private:
 	EQUIVALENT_ARRAY(m_glyphs, glyph *) m_glyphs_cmd; // array of glyph subtables
 	std::vector<char>   m_rawdata_cmd;      // pointer to the raw data for the font
 
+	render_font_atlas   m_atlas;            // expanded glyphs
+
+	// widths of recently measured strings, keyed on a hash of their text
+	std::unordered_map<u64, s32> m_string_widths;
+
 	// constants
 	static const u64 CACHED_BDF_HASH_SIZE   = 1024;
+	static const size_t STRING_WIDTH_CACHE_SIZE = 1024;
 };
 
 void convert_command_glyph(std::string &s);
@@ -23,6 +23,7 @@
 ***************************************************************************/
 
 #define TEMPBUFFER_MAX_SIZE     (1024 * 1024 * 1024)
+#define PREFETCH_MAX_BYTES      (256 * 1024 * 1024)
 
 /***************************************************************************
     HELPERS (also used by diimage.cpp)
@@ -40,9 +41,10 @@ static osd_file::error common_process_file(emu_options &options, const char *loc
 	return filerr;
 }
 
-std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, u32 crc, const rom_entry *romp, osd_file::error &filerr)
+std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, u32 crc, const rom_entry *romp, osd_file::error &filerr, hash_cache *cache)
 {
 	auto image_file = std::make_unique<emu_file>(options.media_path(), OPEN_FLAG_READ);
+	image_file->set_hash_cache(cache);
 
 	if (has_crc)
 		filerr = image_file->open(location, PATH_SEPARATOR, ROM_GETNAME(romp), crc);
@@ -549,27 +551,49 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 {
 	osd_file::error filerr = osd_file::error::NOT_FOUND;
 	u32 romsize = rom_file_size(romp);
-	tried_file_names = "";
 
 	/* update status display */
 	display_loading_rom_message(ROM_GETNAME(romp), from_list);
 
+	/* use the file opened ahead of time if there is one, otherwise search now */
+	if (!take_prefetch(romp, tried_file_names, filerr))
+		m_file = find_rom_file(regiontag, romp, tried_file_names, filerr);
+
+	/* update counters */
+	m_romsloaded++;
+	m_romsloadedsize += romsize;
+
+	/* return the result */
+	return (filerr == osd_file::error::NONE);
+}
+
+
+/*-------------------------------------------------
+    find_rom_file - search for a ROM file; safe
+    to call from worker threads
+-------------------------------------------------*/
+
+std::unique_ptr<emu_file> rom_load_manager::find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, osd_file::error &filerr)
+{
+	filerr = osd_file::error::NOT_FOUND;
+	tried_file_names = "";
+
 	/* extract CRC to use for searching */
 	u32 crc = 0;
 	bool has_crc = util::hash_collection(ROM_GETHASHDATA(romp)).crc(crc);
 
 	/* attempt reading up the chain through the parents. It automatically also
 	 attempts any kind of load by checksum supported by the archives. */
-	m_file = nullptr;
-	for (int drv = driver_list::find(machine().system()); m_file == nullptr && drv != -1; drv = driver_list::clone(drv)) {
+	std::unique_ptr<emu_file> file;
+	for (int drv = driver_list::find(machine().system()); file == nullptr && drv != -1; drv = driver_list::clone(drv)) {
 		if (tried_file_names.length() != 0)
 			tried_file_names += " ";
 		tried_file_names += driver_list::driver(drv).name;
-		m_file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr);
+		file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr, m_hash_cache.get());
 	}
 
 	/* if the region is load by name, load the ROM from there */
-	if (m_file == nullptr && regiontag != nullptr)
+	if (file == nullptr && regiontag != nullptr)
 	{
 		// check if we are dealing with softwarelists. if so, locationtag
 		// is actually a concatenation of: listname + setname + parentname
@@ -618,43 +642,192 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 		if (!is_list)
 		{
 			tried_file_names += " " + tag1;
-			m_file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr);
+			file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr, m_hash_cache.get());
 		}
 		else
 		{
 			// try to load from list/setname
-			if ((m_file == nullptr) && (tag2.c_str() != nullptr))
+			if ((file == nullptr) && (tag2.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag2;
-				m_file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr, m_hash_cache.get());
 			}
 			// try to load from list/parentname
-			if ((m_file == nullptr) && has_parent && (tag3.c_str() != nullptr))
+			if ((file == nullptr) && has_parent && (tag3.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag3;
-				m_file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr, m_hash_cache.get());
 			}
 			// try to load from setname
-			if ((m_file == nullptr) && (tag4.c_str() != nullptr))
+			if ((file == nullptr) && (tag4.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag4;
-				m_file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr, m_hash_cache.get());
 			}
 			// try to load from parentname
-			if ((m_file == nullptr) && has_parent && (tag5.c_str() != nullptr))
+			if ((file == nullptr) && has_parent && (tag5.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag5;
-				m_file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr, m_hash_cache.get());
 			}
 		}
 	}
 
-	/* update counters */
-	m_romsloaded++;
-	m_romsloadedsize += romsize;
+	return file;
+}
 
-	/* return the result */
-	return (filerr == osd_file::error::NONE);
+
+/*-------------------------------------------------
+    start_prefetch - list the ROM files that will
+    be loaded and start opening them on the work
+    queue, so archives are inflated in parallel
+-------------------------------------------------*/
+
+void rom_load_manager::start_prefetch()
+{
+	for (device_t &device : device_iterator(machine().root_device()))
+		for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
+			if (ROMREGION_ISROMDATA(region))
+				for (const rom_entry *romp = rom_first_file(region); romp != nullptr; romp = rom_next_file(romp))
+					if (ROM_GETBIOSFLAGS(romp) == 0 || ROM_GETBIOSFLAGS(romp) == device.system_bios())
+						m_prefetch.push_back(prefetch_file{ this, device.shortname(), romp, nullptr, nullptr, osd_file::error::NOT_FOUND, std::string(), false });
+
+	/* nothing to gain from a single file */
+	if (m_prefetch.size() < 2)
+	{
+		m_prefetch.clear();
+		return;
+	}
+
+	m_prefetch_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (m_prefetch_queue == nullptr)
+	{
+		m_prefetch.clear();
+		return;
+	}
+	queue_prefetch();
+}
+
+
+/*-------------------------------------------------
+    queue_prefetch - queue more files while the
+    decompressed data waiting to be consumed is
+    under the limit
+-------------------------------------------------*/
+
+void rom_load_manager::queue_prefetch()
+{
+	while (m_prefetch_queued < m_prefetch.size() && (m_prefetch_queued == m_prefetch_taken || m_prefetch_bytes < PREFETCH_MAX_BYTES))
+	{
+		prefetch_file &entry = m_prefetch[m_prefetch_queued++];
+		m_prefetch_bytes += rom_file_size(entry.romp);
+		entry.item = osd_work_item_queue(m_prefetch_queue, prefetch_callback, &entry, 0);
+	}
+}
+
+
+/*-------------------------------------------------
+    take_prefetch - hand over the next prefetched
+    file if it is the one being asked for
+-------------------------------------------------*/
+
+bool rom_load_manager::take_prefetch(const rom_entry *romp, std::string &tried_file_names, osd_file::error &filerr)
+{
+	/* find the file; ROMs that weren't listed (e.g. from software lists) are searched for directly */
+	std::size_t index = m_prefetch_taken;
+	while (index < m_prefetch.size() && m_prefetch[index].romp != romp)
+		index++;
+	if (index >= m_prefetch.size())
+		return false;
+
+	/* if the loader passed over any files, drop them and carry on from here */
+	if (index != m_prefetch_taken)
+	{
+		LOG(("Prefetch skipping %d unused files\n", int(index - m_prefetch_taken)));
+		while (m_prefetch_taken < index)
+			finish_prefetch(m_prefetch[m_prefetch_taken++]);
+		m_prefetch_queued = std::max(m_prefetch_queued, m_prefetch_taken);
+		queue_prefetch();
+	}
+
+	prefetch_file &entry = m_prefetch[m_prefetch_taken++];
+	finish_prefetch(entry);
+	queue_prefetch();
+
+	/* if the search threw, repeat it here so the error is reported normally */
+	if (!entry.valid)
+		return false;
+
+	m_file = std::move(entry.file);
+	filerr = entry.filerr;
+	tried_file_names = std::move(entry.tried_file_names);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    finish_prefetch - wait for a queued file and
+    release its work item
+-------------------------------------------------*/
+
+void rom_load_manager::finish_prefetch(prefetch_file &entry)
+{
+	if (entry.item == nullptr)
+		return;
+
+	while (!osd_work_item_wait(entry.item, osd_ticks_per_second())) { }
+	osd_work_item_release(entry.item);
+	entry.item = nullptr;
+	m_prefetch_bytes -= rom_file_size(entry.romp);
+}
+
+
+/*-------------------------------------------------
+    stop_prefetch - wait for outstanding work and
+    discard anything that wasn't used
+-------------------------------------------------*/
+
+void rom_load_manager::stop_prefetch()
+{
+	/* items have to be released before the queue that owns them is freed */
+	for (prefetch_file &entry : m_prefetch)
+		finish_prefetch(entry);
+	if (m_prefetch_queue != nullptr)
+	{
+		osd_work_queue_free(m_prefetch_queue);
+		m_prefetch_queue = nullptr;
+	}
+	m_prefetch.clear();
+	m_prefetch_queued = m_prefetch_taken = 0;
+	m_prefetch_bytes = 0;
+}
+
+
+/*-------------------------------------------------
+    prefetch_callback - open a ROM file and
+    decompress and hash it on a worker thread
+-------------------------------------------------*/
+
+void *rom_load_manager::prefetch_callback(void *param, int threadid)
+{
+	prefetch_file &entry = *reinterpret_cast<prefetch_file *>(param);
+	try
+	{
+		entry.file = entry.manager->find_rom_file(entry.location, entry.romp, entry.tried_file_names, entry.filerr);
+		if (entry.file != nullptr)
+		{
+			/* seeking inflates archive members; hash while the data is hot */
+			entry.file->seek(0, SEEK_SET);
+			entry.file->hashes(util::hash_collection(ROM_GETHASHDATA(entry.romp)).hash_types().c_str());
+		}
+		entry.valid = true;
+	}
+	catch (...)
+	{
+		entry.file = nullptr;
+		entry.valid = false;
+	}
+	return nullptr;
 }
 
 
@@ -858,6 +1031,18 @@ void rom_load_manager::copy_rom_data(const rom_entry *romp)
 }
 
 
+/*-------------------------------------------------
+    save_hash_cache - write back archive contents
+    and hashes learned while loading
+-------------------------------------------------*/
+
+void rom_load_manager::save_hash_cache()
+{
+	if (m_hash_cache != nullptr && !m_hash_cache->save(machine().options().hash_cache()))
+		osd_printf_warning("Error saving hash cache %s\n", machine().options().hash_cache());
+}
+
+
 /*-------------------------------------------------
     process_rom_entries - process all ROM entries
     for a region
@@ -1372,6 +1557,7 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 	}
 
 	/* display the results and exit */
+	save_hash_cache();
 	display_rom_load_results(true);
 }
 
@@ -1384,51 +1570,64 @@ void rom_load_manager::process_region_list()
 {
 	std::string regiontag;
 
+	/* open and decompress the files on the work queue while we consume them in order */
+	start_prefetch();
+
 	/* loop until we hit the end */
 	device_iterator deviter(machine().root_device());
-	for (device_t &device : deviter)
-		for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
-		{
-			u32 regionlength = ROMREGION_GETLENGTH(region);
+	try
+	{
+		for (device_t &device : deviter)
+			for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
+			{
+				u32 regionlength = ROMREGION_GETLENGTH(region);
 
-			regiontag = rom_region_name(device, region);
-			LOG(("Processing region \"%s\" (length=%X)\n", regiontag.c_str(), regionlength));
+				regiontag = rom_region_name(device, region);
+				LOG(("Processing region \"%s\" (length=%X)\n", regiontag.c_str(), regionlength));
 
-			/* the first entry must be a region */
-			assert(ROMENTRY_ISREGION(region));
+				/* the first entry must be a region */
+				assert(ROMENTRY_ISREGION(region));
 
-			if (ROMREGION_ISROMDATA(region))
-			{
-				/* if this is a device region, override with the device width and endianness */
-				u8 width = ROMREGION_GETWIDTH(region) / 8;
-				endianness_t endianness = ROMREGION_ISBIGENDIAN(region) ? ENDIANNESS_BIG : ENDIANNESS_LITTLE;
-				if (machine().device(regiontag.c_str()) != nullptr)
-					normalize_flags_for_device(machine(), regiontag.c_str(), width, endianness);
+				if (ROMREGION_ISROMDATA(region))
+				{
+					/* if this is a device region, override with the device width and endianness */
+					u8 width = ROMREGION_GETWIDTH(region) / 8;
+					endianness_t endianness = ROMREGION_ISBIGENDIAN(region) ? ENDIANNESS_BIG : ENDIANNESS_LITTLE;
+					if (machine().device(regiontag.c_str()) != nullptr)
+						normalize_flags_for_device(machine(), regiontag.c_str(), width, endianness);
 
-				/* remember the base and length */
-				m_region = machine().memory().region_alloc(regiontag.c_str(), regionlength, width, endianness);
-				LOG(("Allocated %X bytes @ %p\n", m_region->bytes(), m_region->base()));
+					/* remember the base and length */
+					m_region = machine().memory().region_alloc(regiontag.c_str(), regionlength, width, endianness);
+					LOG(("Allocated %X bytes @ %p\n", m_region->bytes(), m_region->base()));
 
-				/* clear the region if it's requested */
-				if (ROMREGION_ISERASE(region))
-					memset(m_region->base(), ROMREGION_GETERASEVAL(region), m_region->bytes());
+					/* clear the region if it's requested */
+					if (ROMREGION_ISERASE(region))
+						memset(m_region->base(), ROMREGION_GETERASEVAL(region), m_region->bytes());
 
-				/* or if it's sufficiently small (<= 4MB) */
-				else if (m_region->bytes() <= 0x400000)
-					memset(m_region->base(), 0, m_region->bytes());
+					/* or if it's sufficiently small (<= 4MB) */
+					else if (m_region->bytes() <= 0x400000)
+						memset(m_region->base(), 0, m_region->bytes());
 
 #ifdef MAME_DEBUG
-				/* if we're debugging, fill region with random data to catch errors */
-				else
-					fill_random(m_region->base(), m_region->bytes());
+					/* if we're debugging, fill region with random data to catch errors */
+					else
+						fill_random(m_region->base(), m_region->bytes());
 #endif
 
-				/* now process the entries in the region */
-				process_rom_entries(device.shortname(), region, region + 1, &device, false);
+					/* now process the entries in the region */
+					process_rom_entries(device.shortname(), region, region + 1, &device, false);
+				}
+				else if (ROMREGION_ISDISKDATA(region))
+					process_disk_entries(regiontag.c_str(), region, region + 1, nullptr);
 			}
-			else if (ROMREGION_ISDISKDATA(region))
-				process_disk_entries(regiontag.c_str(), region, region + 1, nullptr);
-		}
+	}
+	catch (...)
+	{
+		/* don't leave workers writing into our state */
+		stop_prefetch();
+		throw;
+	}
+	stop_prefetch();
 
 	/* now go back and post-process all the regions */
 	for (device_t &device : deviter)
@@ -1455,6 +1654,10 @@ void rom_load_manager::process_region_list()
 
 rom_load_manager::rom_load_manager(running_machine &machine)
 	: m_machine(machine)
+	, m_prefetch_queue(nullptr)
+	, m_prefetch_queued(0)
+	, m_prefetch_taken(0)
+	, m_prefetch_bytes(0)
 {
 	/* figure out which BIOS we are using */
 
@@ -1478,6 +1681,15 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 	/* count the total number of ROMs */
 	count_roms();
 
+	/* pick up what we learned about the archives last time, if asked to */
+	const char *const cachefile = machine.options().hash_cache();
+	if (cachefile != nullptr && *cachefile != 0)
+	{
+		m_hash_cache = std::make_unique<hash_cache>();
+		if (!m_hash_cache->load(cachefile))
+			osd_printf_verbose("Hash cache %s not loaded, starting a new one\n", cachefile);
+	}
+
 	/* reset the disk list */
 	m_chd_list.clear();
 
@@ -1485,6 +1697,7 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 	process_region_list();
 
 	/* display the results and exit */
+	save_hash_cache();
 	display_rom_load_results(false);
 }
 
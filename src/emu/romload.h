@@ -176,6 +176,18 @@ class rom_load_manager
 		chd_file            m_diffchd;              /* handle to the diff CHD */
 	};
 
+	struct prefetch_file
+	{
+		rom_load_manager *          manager;            /* owner, for the worker callback */
+		const char *                location;           /* location tag passed to open_rom_file */
+		const rom_entry *           romp;               /* ROM being opened */
+		osd_work_item *             item;               /* work item, once queued */
+		std::unique_ptr<emu_file>   file;               /* opened and decompressed file */
+		osd_file::error             filerr;             /* result of the search */
+		std::string                 tried_file_names;   /* locations searched */
+		bool                        valid;              /* search completed without throwing */
+	};
+
 public:
 	// construction/destruction
 	rom_load_manager(running_machine &machine);
@@ -212,6 +224,13 @@ private:
 	void display_rom_load_results(bool from_list);
 	void region_post_process(const char *rgntag, bool invert);
 	int open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list);
+	std::unique_ptr<emu_file> find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, osd_file::error &filerr);
+	void start_prefetch();
+	void queue_prefetch();
+	bool take_prefetch(const rom_entry *romp, std::string &tried_file_names, osd_file::error &filerr);
+	void finish_prefetch(prefetch_file &entry);
+	void stop_prefetch();
+	static void *prefetch_callback(void *param, int threadid);
 	int rom_fread(u8 *buffer, int length, const rom_entry *parent_region);
 	int read_rom_data(const rom_entry *parent_region, const rom_entry *romp);
 	void fill_rom_data(const rom_entry *romp);
@@ -221,6 +240,7 @@ private:
 	void process_disk_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, const char *locationtag);
 	void normalize_flags_for_device(running_machine &machine, const char *rgntag, u8 &width, endianness_t &endian);
 	void process_region_list();
+	void save_hash_cache();
 
 
 	// internal state
@@ -236,8 +256,15 @@ private:
 	u32                 m_romstotalsize;      // total size of ROMs to read
 
 	std::unique_ptr<emu_file>  m_file;               /* current file */
+	std::unique_ptr<hash_cache> m_hash_cache;        /* archive contents and hashes from previous runs */
 	std::vector<std::unique_ptr<open_chd>> m_chd_list;     /* disks */
 
+	osd_work_queue *    m_prefetch_queue;     // queue for opening ROM files ahead of use
+	std::vector<prefetch_file> m_prefetch;    // ROM files in the order they will be loaded
+	std::size_t         m_prefetch_queued;    // number of files queued so far
+	std::size_t         m_prefetch_taken;     // number of files consumed so far
+	u64                 m_prefetch_bytes;     // bytes queued but not yet consumed
+
 	memory_region *     m_region;             // info about current region
 
 	std::string         m_errorstring;        // error string
@@ -247,7 +274,7 @@ private:
 
 /* ----- Helpers ----- */
 
-std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, u32 crc, const rom_entry *romp, osd_file::error &filerr);
+std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, u32 crc, const rom_entry *romp, osd_file::error &filerr, hash_cache *cache = nullptr);
 
 /* return pointer to the first ROM region within a source */
 const rom_entry *rom_first_region(const device_t &device);
@@ -321,6 +321,77 @@ save_error save_manager::write_file(emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  binary_size - return the number of bytes
+//  needed to hold the state in memory
+//-------------------------------------------------
+
+size_t save_manager::binary_size() const
+{
+	size_t total = 0;
+	for (auto &entry : m_entry_list)
+		total += entry->m_typesize * entry->m_typecount;
+	return total;
+}
+
+
+//-------------------------------------------------
+//  save_binary - copy the state into memory,
+//  with no header and no compression
+//-------------------------------------------------
+
+save_error save_manager::save_binary(void *buf, size_t size)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (size != binary_size())
+		return STATERR_WRITE_ERROR;
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	// then copy all the data
+	u8 *dst = reinterpret_cast<u8 *>(buf);
+	for (auto &entry : m_entry_list)
+	{
+		u32 totalsize = entry->m_typesize * entry->m_typecount;
+		memcpy(dst, entry->m_data, totalsize);
+		dst += totalsize;
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  load_binary - restore a state copied by
+//  save_binary
+//-------------------------------------------------
+
+save_error save_manager::load_binary(const void *buf, size_t size)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (size != binary_size())
+		return STATERR_READ_ERROR;
+
+	// copy all the data back
+	const u8 *src = reinterpret_cast<const u8 *>(buf);
+	for (auto &entry : m_entry_list)
+	{
+		u32 totalsize = entry->m_typesize * entry->m_typecount;
+		memcpy(entry->m_data, src, totalsize);
+		src += totalsize;
+	}
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
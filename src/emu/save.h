@@ -153,6 +153,11 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// in-memory states, uncompressed and in native byte order, for use within a session
+	size_t binary_size() const;
+	save_error save_binary(void *buf, size_t size);
+	save_error load_binary(const void *buf, size_t size);
+
 private:
 	// internal helpers
 	u32 signature() const;
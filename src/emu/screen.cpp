@@ -1179,6 +1179,7 @@ bool screen_device::update_partial(int scanline)
 	// otherwise, render
 	LOG_PARTIAL_UPDATES(("updating %d-%d\n", clip.min_y, clip.max_y));
 	g_profiler.start(PROFILER_VIDEO);
+	osd_ticks_t const benchstart = machine().video().bench_start();
 
 	u32 flags;
 	if (m_type != SCREEN_TYPE_SVG)
@@ -1197,6 +1198,7 @@ bool screen_device::update_partial(int scanline)
 	}
 
 	m_partial_updates_this_frame++;
+	machine().video().bench_stop(video_manager::BENCH_VIDEO, benchstart);
 	g_profiler.stop();
 
 	// if we modified the bitmap, we have to commit
@@ -1264,6 +1266,7 @@ void screen_device::update_now()
 			if ((clip.min_x <= clip.max_x) && (clip.min_y <= clip.max_y))
 			{
 				g_profiler.start(PROFILER_VIDEO);
+				osd_ticks_t const benchstart = machine().video().bench_start();
 
 				screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
 				switch (curbitmap.format())
@@ -1274,6 +1277,7 @@ void screen_device::update_now()
 				}
 
 				m_partial_updates_this_frame++;
+				machine().video().bench_stop(video_manager::BENCH_VIDEO, benchstart);
 				g_profiler.stop();
 				m_partial_scan_hpos = 0;
 				m_last_partial_scan = current_vpos + 1;
@@ -1301,6 +1305,7 @@ void screen_device::update_now()
 	if ((clip.min_x <= clip.max_x) && (clip.min_y <= clip.max_y))
 	{
 		g_profiler.start(PROFILER_VIDEO);
+		osd_ticks_t const benchstart = machine().video().bench_start();
 
 		LOG_PARTIAL_UPDATES(("doing scanline partial draw: Y %d X %d-%d\n", clip.max_y, clip.min_x, clip.max_x));
 
@@ -1314,6 +1319,7 @@ void screen_device::update_now()
 		}
 
 		m_partial_updates_this_frame++;
+		machine().video().bench_stop(video_manager::BENCH_VIDEO, benchstart);
 		g_profiler.stop();
 
 		// if we modified the bitmap, we have to commit
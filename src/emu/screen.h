@@ -252,6 +252,8 @@ public:
 	// internal to the video system
 	bool update_quads();
 	void update_burnin();
+	bool changed() const { return m_changed; }
+	bitmap_t &curbitmap() { return m_bitmap[m_curbitmap]; }
 
 	// globally accessible constants
 	static constexpr int DEFAULT_FRAME_RATE = 60;
@@ -65,6 +65,10 @@ sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample
 		m_output_sampindex(0),
 		m_output_update_sampindex(0),
 		m_output_base_sampindex(0),
+		m_saved_new_sample_rate(0),
+		m_saved_sampindex(0),
+		m_saved_update_sampindex(0),
+		m_saved_base_sampindex(0),
 		m_callback(std::move(callback))
 {
 	// get the device's sound interface
@@ -446,6 +450,44 @@ void sound_stream::apply_sample_rate_changes()
 }
 
 
+//-------------------------------------------------
+//  save_output - remember the generated output
+//  and buffer positions
+//-------------------------------------------------
+
+void sound_stream::save_output()
+{
+	m_saved_new_sample_rate = m_new_sample_rate;
+	m_saved_sampindex = m_output_sampindex;
+	m_saved_update_sampindex = m_output_update_sampindex;
+	m_saved_base_sampindex = m_output_base_sampindex;
+	m_saved_buffers.resize(m_output.size());
+	for (unsigned int outputnum = 0; outputnum < m_output.size(); outputnum++)
+		m_saved_buffers[outputnum] = m_output[outputnum].m_buffer;
+}
+
+
+//-------------------------------------------------
+//  restore_output - put back what save_output
+//  remembered; this follows a state load, which
+//  has already restored the sample rate and
+//  reallocated the buffers to suit it
+//-------------------------------------------------
+
+void sound_stream::restore_output()
+{
+	m_new_sample_rate = m_saved_new_sample_rate;
+	m_output_sampindex = m_saved_sampindex;
+	m_output_update_sampindex = m_saved_update_sampindex;
+	m_output_base_sampindex = m_saved_base_sampindex;
+	for (unsigned int outputnum = 0; outputnum < m_output.size(); outputnum++)
+	{
+		std::vector<stream_sample_t> const &saved = m_saved_buffers[outputnum];
+		std::copy(saved.begin(), saved.begin() + std::min(saved.size(), m_output[outputnum].m_buffer.size()), m_output[outputnum].m_buffer.begin());
+	}
+}
+
+
 //-------------------------------------------------
 //  recompute_sample_rate_data - recompute sample
 //  rate data, and all streams that are affected
@@ -818,6 +860,8 @@ sound_manager::sound_manager(running_machine &machine)
 		m_attenuation(0),
 		m_nosound_mode(machine.osd().no_sound()),
 		m_wavfile(nullptr),
+		m_output_suppressed(false),
+		m_suppressed_leftover(0),
 		m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds()),
 		m_last_update(attotime::zero)
 {
@@ -911,6 +955,39 @@ void sound_manager::set_attenuation(int attenuation)
 }
 
 
+//-------------------------------------------------
+//  suppress_output - keep mixing, but don't send
+//  the result to the OSD or any recording; used
+//  while emulating frames that will be discarded
+//
+//  Sound updates don't line up with frames, so
+//  the streams usually hold samples generated
+//  before the frames started. Loading a state
+//  would throw those away and generate them again
+//  from the restored chips, which clicks, so the
+//  streams are remembered here and put back when
+//  output is resumed; that has to happen after
+//  the state has been restored.
+//-------------------------------------------------
+
+void sound_manager::suppress_output(bool suppress)
+{
+	if (suppress && !m_output_suppressed)
+	{
+		m_suppressed_leftover = m_finalmix_leftover;
+		for (auto &stream : m_stream_list)
+			stream->save_output();
+	}
+	else if (!suppress && m_output_suppressed)
+	{
+		m_finalmix_leftover = m_suppressed_leftover;
+		for (auto &stream : m_stream_list)
+			stream->restore_output();
+	}
+	m_output_suppressed = suppress;
+}
+
+
 //-------------------------------------------------
 //  indexed_mixer_input - return the mixer
 //  device and input index of the global mixer
@@ -1057,6 +1134,7 @@ void sound_manager::update(void *ptr, int param)
 	VPRINTF(("sound_update\n"));
 
 	g_profiler.start(PROFILER_SOUND);
+	osd_ticks_t const benchstart = machine().video().bench_start();
 
 	// force all the speaker streams to generate the proper number of samples
 	int samples_this_update = 0;
@@ -1091,12 +1169,13 @@ void sound_manager::update(void *ptr, int param)
 	m_finalmix_leftover = sample - samples_this_update * 1000;
 
 	// play the result
-	if (finalmix_offset > 0)
+	if (finalmix_offset > 0 && !m_output_suppressed)
 	{
 		if (!m_nosound_mode)
 			machine().osd().update_audio_stream(finalmix, finalmix_offset / 2);
 		machine().osd().add_audio_to_recording(finalmix, finalmix_offset / 2);
 		machine().video().add_sound_to_recording(finalmix, finalmix_offset / 2);
+		machine().video().add_sound_to_bench(finalmix, finalmix_offset / 2);
 		if (m_wavfile != nullptr)
 			wav_add_data_16(m_wavfile, finalmix, finalmix_offset);
 	}
@@ -1121,5 +1200,6 @@ void sound_manager::update(void *ptr, int param)
 	for (auto &stream : m_stream_list)
 		stream->apply_sample_rate_changes();
 
+	machine().video().bench_stop(video_manager::BENCH_SOUND, benchstart);
 	g_profiler.stop();
 }
@@ -127,6 +127,8 @@ private:
 	// helpers called by our friends only
 	void update_with_accounting(bool second_tick);
 	void apply_sample_rate_changes();
+	void save_output();
+	void restore_output();
 
 	// internal helpers
 	void recompute_sample_rate_data();
@@ -168,6 +170,13 @@ private:
 	s32                 m_output_update_sampindex;    // position at time of last global update
 	s32                 m_output_base_sampindex;      // sample at base of buffer, relative to the current emulated second
 
+	// output saved by save_output, which save states don't cover
+	u32                 m_saved_new_sample_rate;      // pending sample rate change
+	s32                 m_saved_sampindex;            // m_output_sampindex
+	s32                 m_saved_update_sampindex;     // m_output_update_sampindex
+	s32                 m_saved_base_sampindex;       // m_output_base_sampindex
+	std::vector<std::vector<stream_sample_t>> m_saved_buffers; // output buffers
+
 	// callback information
 	stream_update_delegate  m_callback;                   // callback function
 };
@@ -213,6 +222,7 @@ public:
 	void debugger_mute(bool turn_off = true) { mute(turn_off, MUTE_REASON_DEBUGGER); }
 	void system_mute(bool turn_off = true) { mute(turn_off, MUTE_REASON_SYSTEM); }
 	void system_enable(bool turn_on = true) { mute(!turn_on, MUTE_REASON_SYSTEM); }
+	void suppress_output(bool suppress = true);
 
 	// user gain controls
 	bool indexed_mixer_input(int index, mixer_input &info) const;
@@ -243,6 +253,9 @@ private:
 
 	wav_file *          m_wavfile;
 
+	bool                m_output_suppressed;    // mixing, but not sending the result anywhere
+	u32                 m_suppressed_leftover;  // mix position to return to afterwards
+
 	// streams data
 	std::vector<std::unique_ptr<sound_stream>> m_stream_list;    // list of streams
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
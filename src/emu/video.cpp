@@ -34,6 +34,10 @@
 //  GLOBAL VARIABLES
 //**************************************************************************
 
+// frame time histogram geometry; bucket width is passed by reference to printf
+const int video_manager::FRAME_TIME_BUCKET_US;
+const int video_manager::FRAME_TIME_BUCKETS;
+
 // frameskipping tables
 const bool video_manager::s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS] =
 {
@@ -96,6 +100,19 @@ video_manager::video_manager(running_machine &machine)
 		m_frameskip_adjust(0),
 		m_skipping_this_frame(false),
 		m_average_oversleep(0),
+		m_deadline_throttle(machine.options().deadline_throttle()),
+		m_spin_margin(osd_ticks_per_second() / 2000),
+		m_late_wakeups(0),
+		m_frame_time_last(0),
+		m_frame_time_worst(0),
+		m_frame_time_histogram(FRAME_TIME_BUCKETS, 0),
+		m_runahead(machine.options().runahead()),
+		m_runahead_remaining(0),
+		m_runahead_pending(false),
+		m_runahead_count(0),
+		m_runahead_save_ticks(0),
+		m_runahead_run_ticks(0),
+		m_runahead_load_ticks(0),
 		m_snap_target(nullptr),
 		m_snap_native(true),
 		m_snap_width(0),
@@ -107,6 +124,16 @@ video_manager::video_manager(running_machine &machine)
 		m_avi_frame_period(attotime::zero),
 		m_avi_next_frame_time(attotime::zero),
 		m_avi_frame(0),
+		m_capture_queue(nullptr),
+		m_capture_next(0),
+		m_capture_avi_error(false),
+		m_capture_mng_error(false),
+		m_capture_items(0),
+		m_capture_stalls(0),
+		m_capture_stall_ticks(0),
+		m_bench_enabled(machine.options().bench_report()[0] != 0),
+		m_bench_frame_ticks(0),
+		m_bench_overhead(0),
 		m_timecode_enabled(false),
 		m_timecode_write(false),
 		m_timecode_text(""),
@@ -121,6 +148,15 @@ video_manager::video_manager(running_machine &machine)
 	// extract initial execution state from global configuration settings
 	update_refresh_speed();
 
+	// run-ahead restores a save state every frame, which the debugger wouldn't follow
+	if (m_runahead != 0 && (machine.debug_flags & DEBUG_FLAG_ENABLED))
+	{
+		osd_printf_warning("Run-ahead is disabled while debugging\n");
+		m_runahead = 0;
+	}
+	else if (m_runahead != 0 && !(machine.system().flags & MACHINE_SUPPORTS_SAVE))
+		osd_printf_warning("Save states are not officially supported for this machine; run-ahead may not behave correctly\n");
+
 	// create a render target for snapshots
 	const char *viewname = machine.options().snap_view();
 	m_snap_native = (machine.first_screen() != nullptr && (viewname[0] == 0 || strcmp(viewname, "native") == 0));
@@ -150,6 +186,19 @@ video_manager::video_manager(running_machine &machine)
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
 
+	// frame timings for the benchmark report start from reset
+	if (m_bench_enabled)
+	{
+		std::fill(std::begin(m_bench_ticks), std::end(m_bench_ticks), 0);
+		m_bench_screen_crc.resize(screen_device_iterator(machine.root_device()).count(), 0);
+		machine.add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(&video_manager::bench_reset, this));
+	}
+
+	// movies and snapshots are encoded on a single I/O thread, which keeps them in order
+	m_capture_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+	for (capture_item &item : m_capture)
+		item.manager = this;
+
 	// start recording movie if specified
 	const char *filename = machine.options().mng_write();
 	if (filename[0] != 0)
@@ -200,6 +249,20 @@ void video_manager::set_frameskip(int frameskip)
 
 void video_manager::frame_update(bool from_debugger)
 {
+	// frames emulated ahead only need their screens finished, and the last one shown
+	if (m_runahead_remaining != 0)
+	{
+		if (machine().phase() == MACHINE_PHASE_RUNNING)
+			finish_screen_updates();
+		if (--m_runahead_remaining == 0)
+		{
+			g_profiler.start(PROFILER_BLIT);
+			machine().osd().update(false);
+			g_profiler.stop();
+		}
+		return;
+	}
+
 	// only render sound and video if we're in the running phase
 	int phase = machine().phase();
 	bool skipped_it = m_skipping_this_frame;
@@ -217,17 +280,36 @@ void video_manager::frame_update(bool from_debugger)
 	}
 
 	// draw the user interface
+	osd_ticks_t benchstart = bench_start();
 	emulator_info::draw_user_interface(machine());
+	bench_stop(BENCH_RENDER, benchstart);
 
 	// if we're throttling, synchronize before rendering
 	attotime current_time = machine().time();
 	if (!from_debugger && !skipped_it && effective_throttle())
+	{
+		benchstart = bench_start();
 		update_throttle(current_time);
+		bench_stop(BENCH_THROTTLE, benchstart);
+	}
 
-	// ask the OSD to update
-	g_profiler.start(PROFILER_BLIT);
-	machine().osd().update(!from_debugger && skipped_it);
-	g_profiler.stop();
+	// ask the OSD to update, unless we're going to run ahead and show that frame instead
+	if (m_runahead != 0 && !from_debugger && !skipped_it && phase == MACHINE_PHASE_RUNNING && !machine().paused())
+		m_runahead_pending = true;
+	else
+	{
+		g_profiler.start(PROFILER_BLIT);
+		benchstart = bench_start();
+		machine().osd().update(!from_debugger && skipped_it);
+		bench_stop(BENCH_RENDER, benchstart);
+		g_profiler.stop();
+	}
+
+	// track how evenly frames are being delivered
+	if (!from_debugger && phase == MACHINE_PHASE_RUNNING && !machine().paused())
+		record_frame_time();
+	else
+		m_frame_time_last = 0;
 
 	emulator_info::periodic_check();
 
@@ -252,6 +334,10 @@ void video_manager::frame_update(bool from_debugger)
 		bool const within_instruction_hook = debugger_enabled && machine().debugger().within_instruction_hook();
 		if (screen && (machine().paused() || from_debugger || within_instruction_hook))
 			screen->reset_partial_updates();
+
+		// finish the frame for the benchmark report
+		if (m_bench_enabled && !from_debugger)
+			bench_end_frame();
 	}
 }
 
@@ -329,6 +415,19 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  snapshot_bitmap - render the given screen as
+//  it would appear in a snapshot and return the
+//  bitmap, which is valid until the next snapshot
+//-------------------------------------------------
+
+const bitmap_rgb32 &video_manager::snapshot_bitmap(screen_device *screen)
+{
+	create_snapshot_bitmap(m_snap_native ? screen : nullptr);
+	return m_snap_bitmap;
+}
+
+
 //-------------------------------------------------
 //  save_active_screen_snapshots - save a
 //  snapshot of all active screens
@@ -336,28 +435,35 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 
 void video_manager::save_active_screen_snapshots()
 {
+	// the PNGs are encoded and written by the capture thread; snapshot bitmaps
+	// are always RGB32, so no palette is needed
+	auto const queue_snapshot = [this] (screen_device *screen)
+	{
+		auto file = std::make_unique<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		osd_file::error filerr = open_next(*file, "png");
+		if (filerr != osd_file::error::NONE)
+			return;
+
+		create_snapshot_bitmap(screen);
+		capture_item &item = capture_alloc();
+		item.kind = capture_item::type::SNAPSHOT;
+		std::swap(item.bitmap, m_snap_bitmap);
+		item.file = std::move(file);
+		capture_queue(item);
+	};
+
 	// if we're native, then write one snapshot per visible screen
 	if (m_snap_native)
 	{
 		// write one snapshot per visible screen
 		for (screen_device &screen : screen_device_iterator(machine().root_device()))
 			if (machine().render().is_live(screen))
-			{
-				emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-				osd_file::error filerr = open_next(file, "png");
-				if (filerr == osd_file::error::NONE)
-					save_snapshot(&screen, file);
-			}
+				queue_snapshot(&screen);
 	}
 
 	// otherwise, just write a single snapshot
 	else
-	{
-		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		osd_file::error filerr = open_next(file, "png");
-		if (filerr == osd_file::error::NONE)
-			save_snapshot(nullptr, file);
-	}
+		queue_snapshot(nullptr);
 }
 
 
@@ -517,12 +623,24 @@ void video_manager::begin_recording(const char *name, movie_format format)
 
 void video_manager::end_recording(movie_format format)
 {
+	// let the capture thread finish with the file first
+	if ((format == MF_AVI && m_avi_file) || (format == MF_MNG && m_mng_file != nullptr))
+	{
+		capture_flush();
+		if (m_capture_items != 0)
+			osd_printf_verbose("Movie capture: %u items queued, waited %u times for the encoder (%.1f ms)\n",
+					m_capture_items, m_capture_stalls, double(m_capture_stall_ticks) * 1000.0 / double(osd_ticks_per_second()));
+		m_capture_items = m_capture_stalls = 0;
+		m_capture_stall_ticks = 0;
+	}
+
 	if (format == MF_AVI)
 	{
 		// close the file if it exists
 		if (m_avi_file)
 		{
 			m_avi_file.reset();
+			m_capture_avi_error = false;
 
 			// reset the state
 			m_avi_frame = 0;
@@ -535,6 +653,7 @@ void video_manager::end_recording(movie_format format)
 		{
 			mng_capture_stop(*m_mng_file);
 			m_mng_file.reset();
+			m_capture_mng_error = false;
 
 			// reset the state
 			m_mng_frame = 0;
@@ -550,17 +669,20 @@ void video_manager::end_recording(movie_format format)
 
 void video_manager::add_sound_to_recording(const s16 *sound, int numsamples)
 {
+	// stop if the capture thread couldn't write the last lot
+	if (m_capture_avi_error)
+		end_recording(MF_AVI);
+
 	// only record if we have a file
 	if (m_avi_file != nullptr)
 	{
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_file::error avierr = m_avi_file->append_sound_samples(0, sound + 0, numsamples, 1);
-		if (avierr == avi_file::error::NONE)
-			avierr = m_avi_file->append_sound_samples(1, sound + 1, numsamples, 1);
-		if (avierr != avi_file::error::NONE)
-			end_recording(MF_AVI);
+		// queue a copy of the samples
+		capture_item &item = capture_alloc();
+		item.kind = capture_item::type::SOUND;
+		item.samples.assign(sound, sound + numsamples * 2);
+		capture_queue(item);
 
 		g_profiler.stop();
 	}
@@ -574,14 +696,41 @@ void video_manager::add_sound_to_recording(const s16 *sound, int numsamples)
 
 void video_manager::exit()
 {
-	// stop recording any movie
+	// stop recording any movie, and finish any snapshots
 	end_recording(MF_AVI);
 	end_recording(MF_MNG);
+	capture_flush();
+	osd_work_queue_free(m_capture_queue);
+	m_capture_queue = nullptr;
 
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
 
+	// write out the benchmark report
+	if (m_bench_enabled)
+		bench_write_report();
+
+	// summarize frame pacing
+	u64 frames = 0;
+	for (u32 count : m_frame_time_histogram)
+		frames += count;
+	if (frames != 0)
+	{
+		osd_printf_verbose("Frame time: median %.2f ms, 99th percentile %.2f ms, worst %.2f ms over %u frames\n",
+				frame_time_percentile(0.5), frame_time_percentile(0.99), 1000.0 * double(m_frame_time_worst) / double(osd_ticks_per_second()), unsigned(frames));
+		if (m_deadline_throttle)
+			osd_printf_verbose("Deadline throttle: %u late wakeups, final spin margin %.3f ms\n",
+					m_late_wakeups, 1000.0 * double(m_spin_margin) / double(osd_ticks_per_second()));
+	}
+	if (m_runahead_count != 0)
+	{
+		double const ms_per_frame = 1000.0 / (double(osd_ticks_per_second()) * m_runahead_count);
+		osd_printf_verbose("Run-ahead: %u frames with a %u byte state, per frame %.3f ms saving, %.3f ms emulating, %.3f ms restoring\n",
+				m_runahead_count, unsigned(m_runahead_state.size()),
+				double(m_runahead_save_ticks) * ms_per_frame, double(m_runahead_run_ticks) * ms_per_frame, double(m_runahead_load_ticks) * ms_per_frame);
+	}
+
 	// print a final result if we have at least 2 seconds' worth of data
 	if (!emulator_info::standalone() && m_overall_emutime.seconds() >= 1)
 	{
@@ -593,6 +742,66 @@ void video_manager::exit()
 }
 
 
+//-------------------------------------------------
+//  run_ahead - save the machine, emulate it ahead
+//  with sound and recording suppressed until the
+//  frame to show, and restore it; sound devices
+//  with state that isn't saved (sample players,
+//  some discrete and netlist sound) still carry
+//  changes from the discarded frames forward, as
+//  they would across an ordinary state load
+//-------------------------------------------------
+
+void video_manager::run_ahead()
+{
+	m_runahead_pending = false;
+
+	// anonymous timers can't be saved; just show the frame we have
+	save_manager &save = machine().save();
+	if (!machine().scheduler().can_save())
+	{
+		machine().osd().update(false);
+		return;
+	}
+
+	// remember where we are; registrations are closed by now, so the size won't change
+	osd_ticks_t const start = osd_ticks();
+	if (m_runahead_state.empty())
+		m_runahead_state.resize(save.binary_size());
+	if (save.save_binary(m_runahead_state.data(), m_runahead_state.size()) != STATERR_NONE)
+	{
+		osd_printf_warning("Unable to save state for run-ahead; disabling it\n");
+		m_runahead = 0;
+		machine().osd().update(false);
+		return;
+	}
+	osd_ticks_t const saved = osd_ticks();
+
+	// run until frame_update has shown the last frame ahead
+	m_runahead_remaining = m_runahead;
+	machine().sound().suppress_output(true);
+	while (m_runahead_remaining != 0 && !machine().scheduled_event_pending())
+		machine().scheduler().timeslice();
+	m_runahead_remaining = 0;
+	osd_ticks_t const ran = osd_ticks();
+
+	// go back, keeping the movie timing of the real frames and the sound generated before them
+	attotime const avi_next = m_avi_next_frame_time;
+	attotime const mng_next = m_mng_next_frame_time;
+	save.load_binary(m_runahead_state.data(), m_runahead_state.size());
+	machine().sound().suppress_output(false);
+	m_avi_next_frame_time = avi_next;
+	m_mng_next_frame_time = mng_next;
+	osd_ticks_t const loaded = osd_ticks();
+
+	m_runahead_count++;
+	m_runahead_save_ticks += saved - start;
+	m_runahead_run_ticks += ran - saved;
+	m_runahead_load_ticks += loaded - ran;
+	bench_stop(BENCH_RUNAHEAD, start);
+}
+
+
 //-------------------------------------------------
 //  screenless_update_callback - update generator
 //  when there are no screens to drive it
@@ -696,6 +905,10 @@ bool video_manager::finish_screen_updates()
 	for (screen_device &screen : iter)
 		screen.update_partial(screen.visible_area().max_y);
 
+	// hash the finished frames before the screens flip their bitmaps
+	if (m_bench_enabled && !m_runahead_remaining)
+		bench_hash_screens();
+
 	// now add the quads for all the screens
 	bool anything_changed = m_output_changed;
 	m_output_changed = false;
@@ -706,8 +919,8 @@ bool video_manager::finish_screen_updates()
 	// draw HUD from LUA callback (if any)
 	anything_changed |= emulator_info::frame_hook();
 
-	// update our movie recording and burn-in state
-	if (!machine().paused())
+	// update our movie recording and burn-in state; frames emulated ahead are discarded
+	if (!machine().paused() && !m_runahead_remaining)
 	{
 		record_frame();
 
@@ -889,6 +1102,8 @@ osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 		allowed_to_sleep = true;
 	if (machine().paused())
 		allowed_to_sleep = true;
+	if (allowed_to_sleep && m_deadline_throttle)
+		return throttle_until_deadline(target_ticks);
 
 	// loop until we reach our target
 	g_profiler.start(PROFILER_IDLE);
@@ -933,6 +1148,92 @@ osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 }
 
 
+//-------------------------------------------------
+//  throttle_until_deadline - sleep until just
+//  before the target time and spin the rest,
+//  adjusting how early we wake to the latency
+//  the OSD actually delivers
+//-------------------------------------------------
+
+osd_ticks_t video_manager::throttle_until_deadline(osd_ticks_t target_ticks)
+{
+	osd_ticks_t const ticks_per_second = osd_ticks_per_second();
+
+	g_profiler.start(PROFILER_IDLE);
+	osd_ticks_t current_ticks = osd_ticks();
+	osd_ticks_t const wake_ticks = target_ticks - m_spin_margin;
+	if (current_ticks < wake_ticks)
+	{
+		osd_sleep_until(wake_ticks);
+		current_ticks = osd_ticks();
+
+		// grow the margin straight away when a wakeup is late, and let it
+		// shrink back slowly so one quiet period doesn't undo it
+		osd_ticks_t const latency = (current_ticks > wake_ticks) ? (current_ticks - wake_ticks) : 0;
+		osd_ticks_t const wanted = std::max(latency + latency / 2, ticks_per_second / 20000);
+		if (latency > m_spin_margin)
+			m_late_wakeups++;
+		if (wanted > m_spin_margin)
+			m_spin_margin = std::min(wanted, ticks_per_second / 500);
+		else
+			m_spin_margin -= (m_spin_margin - wanted) / 64;
+
+		if (LOG_THROTTLE)
+			machine().logerror("Woke %d ticks after the deadline, margin = %d\n", (int)latency, (int)m_spin_margin);
+	}
+
+	// spin the remainder
+	while (current_ticks < target_ticks)
+		current_ticks = osd_ticks();
+	g_profiler.stop();
+
+	return current_ticks;
+}
+
+
+//-------------------------------------------------
+//  record_frame_time - add the time since the
+//  last frame to the frame time histogram
+//-------------------------------------------------
+
+void video_manager::record_frame_time()
+{
+	osd_ticks_t const current_ticks = osd_ticks();
+	if (m_frame_time_last != 0)
+	{
+		osd_ticks_t const elapsed = current_ticks - m_frame_time_last;
+		u64 const bucket = elapsed * 1000000 / (osd_ticks_per_second() * FRAME_TIME_BUCKET_US);
+		m_frame_time_histogram[std::min<u64>(bucket, FRAME_TIME_BUCKETS - 1)]++;
+		m_frame_time_worst = std::max(m_frame_time_worst, elapsed);
+	}
+	m_frame_time_last = current_ticks;
+}
+
+
+//-------------------------------------------------
+//  frame_time_percentile - return the frame time
+//  in milliseconds below which the given fraction
+//  of frames fall, to histogram resolution
+//-------------------------------------------------
+
+double video_manager::frame_time_percentile(double fraction) const
+{
+	u64 frames = 0;
+	for (u32 count : m_frame_time_histogram)
+		frames += count;
+
+	u64 const wanted = u64(double(frames) * fraction);
+	u64 seen = 0;
+	for (int bucket = 0; bucket < FRAME_TIME_BUCKETS; bucket++)
+	{
+		seen += m_frame_time_histogram[bucket];
+		if (seen > wanted)
+			return double((bucket + 1) * FRAME_TIME_BUCKET_US) / 1000.0;
+	}
+	return double(FRAME_TIME_BUCKETS * FRAME_TIME_BUCKET_US) / 1000.0;
+}
+
+
 //-------------------------------------------------
 //  update_frameskip - update frameskipping
 //  counters and periodically update autoframeskip
@@ -1266,6 +1567,12 @@ osd_file::error video_manager::open_next(emu_file &file, const char *extension)
 
 void video_manager::record_frame()
 {
+	// stop any recording the capture thread couldn't write
+	if (m_capture_avi_error)
+		end_recording(MF_AVI);
+	if (m_capture_mng_error)
+		end_recording(MF_MNG);
+
 	// ignore if nothing to do
 	if (m_mng_file == nullptr && m_avi_file == nullptr)
 		return;
@@ -1274,39 +1581,134 @@ void video_manager::record_frame()
 	g_profiler.start(PROFILER_MOVIE_REC);
 	attotime curtime = machine().time();
 
-	// create the bitmap
-	create_snapshot_bitmap(nullptr);
-
-	// handle an AVI recording
+	// work out how many times each movie needs the frame
+	u32 avi_frames = 0;
 	if (m_avi_file != nullptr)
+		for ( ; m_avi_next_frame_time <= curtime; m_avi_next_frame_time += m_avi_frame_period)
+			avi_frames++;
+	u32 mng_frames = 0;
+	bool const mng_first = (m_mng_frame == 0);
+	if (m_mng_file != nullptr)
+		for ( ; m_mng_next_frame_time <= curtime; m_mng_next_frame_time += m_mng_frame_period)
+			mng_frames++;
+	m_avi_frame += avi_frames;
+	m_mng_frame += mng_frames;
+
+	// create the bitmap and hand it to the capture thread
+	if (avi_frames != 0 || mng_frames != 0)
 	{
-		// loop until we hit the right time
-		while (m_avi_next_frame_time <= curtime)
-		{
-			// write the next frame
-			avi_file::error avierr = m_avi_file->append_video_frame(m_snap_bitmap);
-			if (avierr != avi_file::error::NONE)
-			{
-				g_profiler.stop();
-				end_recording(MF_AVI);
-				break;
-			}
+		create_snapshot_bitmap(nullptr);
+		capture_item &item = capture_alloc();
+		item.kind = capture_item::type::FRAME;
+		std::swap(item.bitmap, m_snap_bitmap);
+		item.avi_frames = avi_frames;
+		item.mng_frames = mng_frames;
+		item.mng_first = mng_first;
+		capture_queue(item);
+	}
+
+	g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  capture_alloc - get the next capture buffer,
+//  waiting for the capture thread to finish with
+//  it if necessary
+//-------------------------------------------------
+
+video_manager::capture_item &video_manager::capture_alloc()
+{
+	capture_item &item = m_capture[m_capture_next];
+	m_capture_next = (m_capture_next + 1) % CAPTURE_SLOTS;
+	if (item.work != nullptr)
+		capture_reclaim(item, true);
+	m_capture_items++;
+	return item;
+}
+
 
-			// advance time
-			m_avi_next_frame_time += m_avi_frame_period;
-			m_avi_frame++;
+//-------------------------------------------------
+//  capture_queue - hand a filled capture buffer
+//  to the capture thread
+//-------------------------------------------------
+
+void video_manager::capture_queue(capture_item &item)
+{
+	item.work = osd_work_item_queue(m_capture_queue, capture_callback, &item, 0);
+
+	// if the OSD couldn't queue it, write it now
+	if (item.work == nullptr)
+	{
+		capture_write(item);
+		capture_reclaim(item, false);
+	}
+}
+
+
+//-------------------------------------------------
+//  capture_reclaim - wait for the capture thread
+//  to finish with a buffer and report any
+//  snapshot error
+//-------------------------------------------------
+
+void video_manager::capture_reclaim(capture_item &item, bool stalled)
+{
+	if (item.work != nullptr)
+	{
+		if (stalled && !osd_work_item_wait(item.work, 0))
+		{
+			osd_ticks_t const start = osd_ticks();
+			while (!osd_work_item_wait(item.work, osd_ticks_per_second())) { }
+			m_capture_stalls++;
+			m_capture_stall_ticks += osd_ticks() - start;
+		}
+		else
+		{
+			while (!osd_work_item_wait(item.work, osd_ticks_per_second())) { }
 		}
+		osd_work_item_release(item.work);
+		item.work = nullptr;
 	}
 
-	// handle a MNG recording
-	if (m_mng_file != nullptr)
+	if (item.error != PNGERR_NONE)
+		osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", item.error);
+	item.error = PNGERR_NONE;
+	item.file.reset();
+}
+
+
+//-------------------------------------------------
+//  capture_flush - wait for everything queued to
+//  be written
+//-------------------------------------------------
+
+void video_manager::capture_flush()
+{
+	for (int index = 0; index < CAPTURE_SLOTS; index++)
+		capture_reclaim(m_capture[(m_capture_next + index) % CAPTURE_SLOTS], false);
+}
+
+
+//-------------------------------------------------
+//  capture_write - encode and write a capture
+//  buffer; runs on the capture thread
+//-------------------------------------------------
+
+void video_manager::capture_write(capture_item &item)
+{
+	switch (item.kind)
 	{
-		// loop until we hit the right time
-		while (m_mng_next_frame_time <= curtime)
+	case capture_item::type::FRAME:
+		for (u32 frame = 0; frame < item.avi_frames && !m_capture_avi_error; frame++)
+			if (m_avi_file->append_video_frame(item.bitmap) != avi_file::error::NONE)
+				m_capture_avi_error = true;
+
+		for (u32 frame = 0; frame < item.mng_frames && !m_capture_mng_error; frame++)
 		{
 			// set up the text fields in the movie info
 			png_info pnginfo = { nullptr };
-			if (m_mng_frame == 0)
+			if (item.mng_first && frame == 0)
 			{
 				std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
 				std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
@@ -1314,26 +1716,198 @@ void video_manager::record_frame()
 				png_add_text(&pnginfo, "System", text2.c_str());
 			}
 
-			// write the next frame
-			screen_device *screen = machine().first_screen();
-			const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
-			int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
-			png_error error = mng_capture_frame(*m_mng_file, &pnginfo, m_snap_bitmap, entries, palette);
+			// the frame is always RGB32, so no palette is needed
+			if (mng_capture_frame(*m_mng_file, &pnginfo, item.bitmap, 0, nullptr) != PNGERR_NONE)
+				m_capture_mng_error = true;
 			png_free(&pnginfo);
-			if (error != PNGERR_NONE)
-			{
-				g_profiler.stop();
-				end_recording(MF_MNG);
-				break;
-			}
+		}
+		break;
 
-			// advance time
-			m_mng_next_frame_time += m_mng_frame_period;
-			m_mng_frame++;
+	case capture_item::type::SOUND:
+		if (!m_capture_avi_error)
+		{
+			int const numsamples = item.samples.size() / 2;
+			avi_file::error avierr = m_avi_file->append_sound_samples(0, item.samples.data() + 0, numsamples, 1);
+			if (avierr == avi_file::error::NONE)
+				avierr = m_avi_file->append_sound_samples(1, item.samples.data() + 1, numsamples, 1);
+			if (avierr != avi_file::error::NONE)
+				m_capture_avi_error = true;
 		}
+		break;
+
+	case capture_item::type::SNAPSHOT:
+		{
+			std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+			std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
+			png_info pnginfo = { nullptr };
+			png_add_text(&pnginfo, "Software", text1.c_str());
+			png_add_text(&pnginfo, "System", text2.c_str());
+			item.error = png_write_bitmap(*item.file, &pnginfo, item.bitmap, 0, nullptr);
+			png_free(&pnginfo);
+			item.file->close();
+		}
+		break;
 	}
+}
 
-	g_profiler.stop();
+
+//-------------------------------------------------
+//  capture_callback - work queue callback for
+//  the capture thread
+//-------------------------------------------------
+
+void *video_manager::capture_callback(void *param, int threadid)
+{
+	capture_item &item = *reinterpret_cast<capture_item *>(param);
+	item.manager->capture_write(item);
+	return nullptr;
+}
+
+
+
+//-------------------------------------------------
+//  bench_reset - start timing frames for the
+//  benchmark report
+//-------------------------------------------------
+
+void video_manager::bench_reset()
+{
+	std::fill(std::begin(m_bench_ticks), std::end(m_bench_ticks), 0);
+	m_bench_overhead = 0;
+	m_bench_audio.reset();
+	m_bench_frame_ticks = osd_ticks();
+}
+
+
+//-------------------------------------------------
+//  bench_hash_screens - hash the frame each
+//  screen finished drawing; screens that say
+//  they haven't changed keep their last hash
+//-------------------------------------------------
+
+void video_manager::bench_hash_screens()
+{
+	osd_ticks_t const start = osd_ticks();
+	int index = 0;
+	for (screen_device &screen : screen_device_iterator(machine().root_device()))
+	{
+		if (screen.changed() && screen.screen_type() != SCREEN_TYPE_VECTOR)
+		{
+			bitmap_t &bitmap = screen.curbitmap();
+			const rectangle &visarea = screen.visible_area();
+			util::crc32_creator crc;
+			for (int y = visarea.min_y; y <= visarea.max_y; y++)
+				crc.append(bitmap.raw_pixptr(y, visarea.min_x), visarea.width() * bitmap.bpp() / 8);
+
+			// indexed bitmaps are only meaningful with their colours
+			if (bitmap.palette() != nullptr)
+				crc.append(bitmap.palette()->entry_list_raw(), bitmap.palette()->num_colors() * sizeof(rgb_t));
+			m_bench_screen_crc[index] = crc.finish();
+		}
+		index++;
+	}
+	m_bench_overhead += osd_ticks() - start;
+}
+
+
+//-------------------------------------------------
+//  bench_end_frame - record the hashes and host
+//  time for the frame that just finished
+//-------------------------------------------------
+
+void video_manager::bench_end_frame()
+{
+	osd_ticks_t const now = osd_ticks();
+
+	bench_frame frame;
+	frame.time = machine().time();
+	frame.audio = m_bench_audio.finish();
+	frame.total = now - m_bench_frame_ticks - m_bench_overhead;
+	std::copy(std::begin(m_bench_ticks), std::end(m_bench_ticks), std::begin(frame.ticks));
+	m_bench_frames.push_back(frame);
+	m_bench_screens.insert(m_bench_screens.end(), m_bench_screen_crc.begin(), m_bench_screen_crc.end());
+
+	std::fill(std::begin(m_bench_ticks), std::end(m_bench_ticks), 0);
+	m_bench_overhead = 0;
+	m_bench_audio.reset();
+	m_bench_frame_ticks = now;
+}
+
+
+//-------------------------------------------------
+//  bench_write_report - write the benchmark
+//  report as JSON
+//-------------------------------------------------
+
+void video_manager::bench_write_report()
+{
+	static const char *const subsystem_names[BENCH_SUBSYSTEMS] = { "video", "sound", "render", "throttle", "runahead" };
+
+	emu_file file(machine().options().bench_report(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(machine().basename(), ".json") != osd_file::error::NONE)
+	{
+		osd_printf_error("Error creating benchmark report for %s\n", machine().basename());
+		return;
+	}
+
+	// totals across the run; whatever isn't attributed to a subsystem is emulation
+	osd_ticks_t total = 0, cpu = 0;
+	osd_ticks_t subsystems[BENCH_SUBSYSTEMS] = { 0 };
+	for (const bench_frame &frame : m_bench_frames)
+	{
+		total += frame.total;
+		osd_ticks_t attributed = 0;
+		for (int subsystem = 0; subsystem < BENCH_SUBSYSTEMS; subsystem++)
+		{
+			subsystems[subsystem] += frame.ticks[subsystem];
+			attributed += frame.ticks[subsystem];
+		}
+		cpu += (frame.total > attributed) ? (frame.total - attributed) : 0;
+	}
+
+	double const seconds_per_tick = 1.0 / double(osd_ticks_per_second());
+	double const emulated = m_bench_frames.empty() ? 0.0 : m_bench_frames.back().time.as_double();
+	file.printf("{\n");
+	file.printf("\t\"system\": \"%s\",\n", machine().system().name);
+	file.printf("\t\"emulated_seconds\": %.6f,\n", emulated);
+	file.printf("\t\"host_seconds\": %.6f,\n", double(total) * seconds_per_tick);
+	file.printf("\t\"speed_percent\": %.2f,\n", (total != 0) ? (100.0 * emulated / (double(total) * seconds_per_tick)) : 0.0);
+	file.printf("\t\"frames\": %u,\n", unsigned(m_bench_frames.size()));
+	file.printf("\t\"screens\": %u,\n", unsigned(m_bench_screen_crc.size()));
+	file.printf("\t\"host_seconds_by_subsystem\": { \"cpu\": %.6f", double(cpu) * seconds_per_tick);
+	for (int subsystem = 0; subsystem < BENCH_SUBSYSTEMS; subsystem++)
+		file.printf(", \"%s\": %.6f", subsystem_names[subsystem], double(subsystems[subsystem]) * seconds_per_tick);
+	file.printf(" },\n");
+
+	// then each frame, with host times in microseconds
+	double const us_per_tick = 1000000.0 * seconds_per_tick;
+	file.printf("\t\"frame_data\": [\n");
+	for (size_t index = 0; index < m_bench_frames.size(); index++)
+	{
+		const bench_frame &frame = m_bench_frames[index];
+		file.printf("\t\t{ \"time\": %.6f, \"video\": [", frame.time.as_double());
+		for (size_t screen = 0; screen < m_bench_screen_crc.size(); screen++)
+			file.printf("%s\"%08x\"", (screen != 0) ? ", " : "", m_bench_screens[index * m_bench_screen_crc.size() + screen]);
+		file.printf("], \"audio\": \"%08x\", \"host_us\": { \"total\": %.1f", frame.audio, double(frame.total) * us_per_tick);
+		osd_ticks_t attributed = 0;
+		for (int subsystem = 0; subsystem < BENCH_SUBSYSTEMS; subsystem++)
+			attributed += frame.ticks[subsystem];
+		file.printf(", \"cpu\": %.1f", double((frame.total > attributed) ? (frame.total - attributed) : 0) * us_per_tick);
+		for (int subsystem = 0; subsystem < BENCH_SUBSYSTEMS; subsystem++)
+			file.printf(", \"%s\": %.1f", subsystem_names[subsystem], double(frame.ticks[subsystem]) * us_per_tick);
+		file.printf(" } }%s\n", (index + 1 < m_bench_frames.size()) ? "," : "");
+	}
+	file.printf("\t],\n");
+
+	// frame pacing, with trailing empty buckets trimmed
+	int buckets = FRAME_TIME_BUCKETS;
+	while (buckets > 0 && m_frame_time_histogram[buckets - 1] == 0)
+		buckets--;
+	file.printf("\t\"frame_time_histogram\": { \"bucket_us\": %d, \"counts\": [", FRAME_TIME_BUCKET_US);
+	for (int bucket = 0; bucket < buckets; bucket++)
+		file.printf("%s%u", (bucket != 0) ? ", " : "", m_frame_time_histogram[bucket]);
+	file.printf("] }\n");
+	file.printf("}\n");
 }
 
 //-------------------------------------------------
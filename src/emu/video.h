@@ -18,6 +18,10 @@
 #define MAME_EMU_VIDEO_H
 
 #include "aviio.h"
+#include "hashing.h"
+#include "png.h"
+
+#include <atomic>
 
 
 //**************************************************************************
@@ -83,13 +87,32 @@ public:
 	// render a frame
 	void frame_update(bool from_debugger = false);
 
+	// run-ahead; the machine is saved, emulated ahead to the frame that is shown, and restored
+	bool runahead_pending() const { return m_runahead_pending; }
+	void run_ahead();
+
 	// current speed helpers
 	std::string speed_text();
 	double speed_percent() const { return m_speed_percent; }
 
+	// benchmark report; host time not attributed to a subsystem is reported as CPU time
+	enum bench_subsystem
+	{
+		BENCH_VIDEO,                                    // screen updates
+		BENCH_SOUND,                                    // sound mixing
+		BENCH_RENDER,                                   // user interface and OSD update
+		BENCH_THROTTLE,                                 // throttling
+		BENCH_RUNAHEAD,                                 // saving, emulating ahead and restoring
+		BENCH_SUBSYSTEMS
+	};
+	osd_ticks_t bench_start() const { return (m_bench_enabled && !m_runahead_remaining) ? osd_ticks() : 0; }
+	void bench_stop(bench_subsystem subsystem, osd_ticks_t start) { if (m_bench_enabled && !m_runahead_remaining) m_bench_ticks[subsystem] += osd_ticks() - start; }
+	void add_sound_to_bench(const s16 *sound, int numsamples) { if (m_bench_enabled) m_bench_audio.append(sound, numsamples * 2 * sizeof(*sound)); }
+
 	// snapshots
 	void save_snapshot(screen_device *screen, emu_file &file);
 	void save_active_screen_snapshots();
+	const bitmap_rgb32 &snapshot_bitmap(screen_device *screen);
 	void save_input_timecode();
 
 	// movies
@@ -124,6 +147,9 @@ private:
 	bool finish_screen_updates();
 	void update_throttle(attotime emutime);
 	osd_ticks_t throttle_until_ticks(osd_ticks_t target_ticks);
+	osd_ticks_t throttle_until_deadline(osd_ticks_t target_ticks);
+	void record_frame_time();
+	double frame_time_percentile(double fraction) const;
 	void update_frameskip();
 	void update_refresh_speed();
 	void recompute_speed(const attotime &emutime);
@@ -132,6 +158,47 @@ private:
 	void create_snapshot_bitmap(screen_device *screen);
 	void record_frame();
 
+	// benchmark report helpers
+	void bench_reset();
+	void bench_hash_screens();
+	void bench_end_frame();
+	void bench_write_report();
+
+	// capture queue; frames, sound and snapshots are copied here and then
+	// encoded and written in order on a separate thread
+	struct capture_item
+	{
+		enum class type { FRAME, SOUND, SNAPSHOT };
+
+		video_manager *             manager = nullptr;      // owning manager
+		osd_work_item *             work = nullptr;         // work item while queued
+		type                        kind = type::FRAME;     // what to write
+		bitmap_rgb32                bitmap;                 // frame or snapshot image
+		u32                         avi_frames = 0;         // number of times to append the frame to the AVI
+		u32                         mng_frames = 0;         // number of times to append the frame to the MNG
+		bool                        mng_first = false;      // is this the first MNG frame?
+		std::vector<s16>            samples;                // interleaved stereo sound for the AVI
+		std::unique_ptr<emu_file>   file;                   // snapshot destination
+		png_error                   error = PNGERR_NONE;    // snapshot result
+	};
+	static constexpr int CAPTURE_SLOTS = 8;
+
+	// benchmark results for one frame
+	struct bench_frame
+	{
+		attotime                    time;                   // emulated time at the end of the frame
+		u32                         audio;                  // CRC of the sound mixed during the frame
+		osd_ticks_t                 total;                  // host time for the whole frame
+		osd_ticks_t                 ticks[BENCH_SUBSYSTEMS]; // host time by subsystem
+	};
+
+	capture_item &capture_alloc();
+	void capture_queue(capture_item &item);
+	void capture_reclaim(capture_item &item, bool stalled);
+	void capture_flush();
+	void capture_write(capture_item &item);
+	static void *capture_callback(void *param, int threadid);
+
 	// internal state
 	running_machine &   m_machine;                  // reference to our machine
 
@@ -172,6 +239,24 @@ private:
 	bool                m_skipping_this_frame;      // flag: true if we are skipping the current frame
 	osd_ticks_t         m_average_oversleep;        // average number of ticks the OSD oversleeps
 
+	// deadline throttling and frame pacing statistics
+	bool                m_deadline_throttle;        // flag: true if we sleep to absolute deadlines
+	osd_ticks_t         m_spin_margin;              // how far ahead of the deadline we wake to spin
+	u32                 m_late_wakeups;             // number of times we woke after the deadline
+	osd_ticks_t         m_frame_time_last;          // osd_ticks at the end of the last frame
+	osd_ticks_t         m_frame_time_worst;         // longest frame seen
+	std::vector<u32>    m_frame_time_histogram;     // frame counts by host frame time
+
+	// run-ahead
+	int                 m_runahead;                 // number of frames to emulate ahead of the one shown
+	int                 m_runahead_remaining;       // frames left to emulate ahead; nonzero while doing so
+	bool                m_runahead_pending;         // flag: true if the last frame is waiting to be run ahead
+	std::vector<u8>     m_runahead_state;           // machine state to return to
+	u32                 m_runahead_count;           // number of frames run ahead
+	osd_ticks_t         m_runahead_save_ticks;      // total time spent saving state
+	osd_ticks_t         m_runahead_run_ticks;       // total time spent emulating ahead
+	osd_ticks_t         m_runahead_load_ticks;      // total time spent restoring state
+
 	// snapshot stuff
 	render_target *     m_snap_target;              // screen shapshot target
 	bitmap_rgb32        m_snap_bitmap;              // screen snapshot bitmap
@@ -191,10 +276,32 @@ private:
 	attotime            m_avi_next_frame_time;      // time of next frame
 	u32                 m_avi_frame;                // current movie frame number
 
+	// movie and snapshot capture queue
+	osd_work_queue *    m_capture_queue;            // queue for the encoding thread
+	capture_item        m_capture[CAPTURE_SLOTS];   // ring of capture buffers
+	int                 m_capture_next;             // index of the next buffer to fill
+	std::atomic<bool>   m_capture_avi_error;        // set by the encoding thread if the AVI can't be written
+	std::atomic<bool>   m_capture_mng_error;        // set by the encoding thread if the MNG can't be written
+	u32                 m_capture_items;            // items queued since the statistics were reset
+	u32                 m_capture_stalls;           // times we had to wait for a free buffer
+	osd_ticks_t         m_capture_stall_ticks;      // total time spent waiting
+
+	// benchmark report
+	bool                m_bench_enabled;            // are we collecting a benchmark report?
+	osd_ticks_t         m_bench_ticks[BENCH_SUBSYSTEMS]; // host time by subsystem this frame
+	osd_ticks_t         m_bench_frame_ticks;        // host time at the end of the last frame
+	osd_ticks_t         m_bench_overhead;           // host time spent hashing this frame
+	util::crc32_creator m_bench_audio;              // CRC of the sound mixed this frame
+	std::vector<u32>    m_bench_screen_crc;         // CRC of the latest frame from each screen
+	std::vector<u32>    m_bench_screens;            // screen CRCs, one run per frame
+	std::vector<bench_frame> m_bench_frames;        // results for each frame
+
 	static const bool   s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
 	static const int PAUSED_REFRESH_RATE = 30;
+	static const int FRAME_TIME_BUCKET_US = 100;
+	static const int FRAME_TIME_BUCKETS = 500;  // the last bucket holds everything longer
 
 	bool                m_timecode_enabled;     // inp.timecode record enabled
 	bool                m_timecode_write;       // Show/hide timer at right (partial time)
@@ -29,6 +29,7 @@ media_auditor::media_auditor(const driver_enumerator &enumerator)
 	: m_enumerator(enumerator)
 	, m_validation(AUDIT_VALIDATE_FULL)
 	, m_searchpath(nullptr)
+	, m_hash_cache(nullptr)
 {
 }
 
@@ -386,6 +387,7 @@ media_auditor::audit_record &media_auditor::audit_one_rom(const rom_entry *rom)
 	// find the file and checksum it, getting the file length along the way
 	emu_file file(m_enumerator.options().media_path(), OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD);
 	file.set_restrict_to_mediapath(true);
+	file.set_hash_cache(m_hash_cache);
 	path_iterator path(m_searchpath);
 	std::string curpath;
 	while (path.next(curpath, record.name()))
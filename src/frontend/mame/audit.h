@@ -38,6 +38,7 @@
 
 // forward declarations
 class driver_enumerator;
+class hash_cache;
 
 
 
@@ -155,6 +156,9 @@ public:
 	// getters
 	const record_list &records() const { return m_record_list; }
 
+	// setters
+	void set_hash_cache(hash_cache *cache) { m_hash_cache = cache; }
+
 	// audit operations
 	summary audit_media(const char *validation = AUDIT_VALIDATE_FULL);
 	summary audit_device(device_t &device, const char *validation = AUDIT_VALIDATE_FULL);
@@ -175,6 +179,7 @@ private:
 	const driver_enumerator &   m_enumerator;
 	const char *                m_validation;
 	const char *                m_searchpath;
+	hash_cache *                m_hash_cache;
 };
 
 
@@ -1056,6 +1056,8 @@ cheat_manager::cheat_manager(running_machine &machine)
 	: m_machine(machine)
 	, m_disabled(true)
 	, m_symtable(&machine)
+	, m_frame_ticks(0)
+	, m_average_ticks(0)
 {
 	// if the cheat engine is disabled, we're done
 	if (!machine.options().cheat())
@@ -1369,9 +1371,12 @@ void cheat_manager::frame_update()
 	for (auto & elem : m_output)
 		elem.clear();
 
-	// iterate over running cheats and execute them
+	// iterate over running cheats and execute them, timing the lot
+	osd_ticks_t const start = osd_ticks();
 	for (auto &cheat : m_cheatlist)
 		cheat->frame_update();
+	m_frame_ticks = osd_ticks() - start;
+	m_average_ticks = m_average_ticks - m_average_ticks / 16 + m_frame_ticks / 16;
 
 	// increment the frame counter
 	m_framecount++;
@@ -325,6 +325,10 @@ public:
 	// output helpers
 	std::string &get_output_string(int row, ui::text_layout::text_justify justify);
 
+	// host time spent running cheats on the last frame, and averaged over recent frames
+	osd_ticks_t frame_ticks() const { return m_frame_ticks; }
+	osd_ticks_t average_frame_ticks() const { return m_average_ticks; }
+
 	// global helpers
 	static std::string quote_expression(parsed_expression const &expression);
 	static uint64_t execute_frombcd(symbol_table &table, void *ref, int params, uint64_t const *param);
@@ -346,6 +350,8 @@ private:
 	bool                                        m_disabled;     // true if the cheat engine is disabled
 	symbol_table                                m_symtable;     // global symbol table
 	std::unique_ptr<debugger_cpu>               m_cpu;          // debugger interface for cpus/memory
+	osd_ticks_t                                 m_frame_ticks;  // host time for the last frame's cheats
+	osd_ticks_t                                 m_average_ticks; // decaying average of the above
 
 	// constants
 	static constexpr int CHEAT_VERSION = 1;
@@ -22,6 +22,7 @@
 #include "clifront.h"
 #include "xmlfile.h"
 #include "media_ident.h"
+#include "drivcache.h"
 
 #include "osdepend.h"
 #include "softlist_dev.h"
@@ -31,7 +32,11 @@
 #include "pluginopts.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <new>
+#include <thread>
 #include <ctype.h>
 
 
@@ -111,10 +116,9 @@ const options_entry cli_option_entries[] =
 };
 
 void print_summary(
-		const media_auditor &auditor, media_auditor::summary summary, bool record_none_needed,
+		const char *details, media_auditor::summary summary, bool record_none_needed,
 		const char *type, const char *name, const char *parent,
-		unsigned &correct, unsigned &incorrect, unsigned &notfound,
-		util::ovectorstream &buffer)
+		unsigned &correct, unsigned &incorrect, unsigned &notfound)
 {
 	if (summary == media_auditor::NOTFOUND)
 	{
@@ -124,11 +128,7 @@ void print_summary(
 	else if (record_none_needed || (summary != media_auditor::NONE_NEEDED))
 	{
 		// output the summary of the audit
-		buffer.clear();
-		buffer.seekp(0);
-		auditor.summarize(name, &buffer);
-		buffer.put('\0');
-		osd_printf_info("%s", &buffer.vec()[0]);
+		osd_printf_info("%s", details);
 
 		// output the name of the driver and its parent
 		osd_printf_info("%sset %s ", type, name);
@@ -163,6 +163,114 @@ void print_summary(
 	}
 }
 
+const char *summarize(
+		const media_auditor &auditor, media_auditor::summary summary, bool record_none_needed,
+		const char *name, util::ovectorstream &buffer)
+{
+	buffer.clear();
+	buffer.seekp(0);
+	if ((summary != media_auditor::NOTFOUND) && (record_none_needed || (summary != media_auditor::NONE_NEEDED)))
+		auditor.summarize(name, &buffer);
+	buffer.put('\0');
+	return &buffer.vec()[0];
+}
+
+void print_summary(
+		const media_auditor &auditor, media_auditor::summary summary, bool record_none_needed,
+		const char *type, const char *name, const char *parent,
+		unsigned &correct, unsigned &incorrect, unsigned &notfound,
+		util::ovectorstream &buffer)
+{
+	print_summary(
+			summarize(auditor, summary, record_none_needed, name, buffer), summary, record_none_needed,
+			type, name, parent,
+			correct, incorrect, notfound);
+}
+
+void audit_drivers_parallel(
+		driver_enumerator &drivlist, hash_cache *cache, unsigned threads,
+		unsigned &matched, unsigned &correct, unsigned &incorrect, unsigned &notfound)
+{
+	struct result
+	{
+		bool                    done = false;
+		media_auditor::summary  summary = media_auditor::NOTFOUND;
+		std::string             details;
+		std::exception_ptr      error;
+	};
+
+	std::vector<int> drivers;
+	while (drivlist.next())
+		drivers.push_back(drivlist.current());
+
+	std::vector<result> results(drivers.size());
+	std::atomic<std::size_t> next(0);
+	std::mutex mutex;
+	std::condition_variable done;
+
+	// each worker needs its own enumerator since it caches machine configurations
+	auto const worker = [&drivlist, cache, &drivers, &results, &next, &mutex, &done] ()
+	{
+		driver_enumerator enumerator(drivlist.options());
+		media_auditor auditor(enumerator);
+		auditor.set_hash_cache(cache);
+		util::ovectorstream buffer;
+		for (std::size_t index = next++; index < drivers.size(); index = next++)
+		{
+			result current;
+			try
+			{
+				enumerator.set_current(drivers[index]);
+				current.summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+				current.details = summarize(auditor, current.summary, true, enumerator.driver().name, buffer);
+			}
+			catch (...)
+			{
+				current.error = std::current_exception();
+				next = drivers.size();
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			current.done = true;
+			results[index] = std::move(current);
+			done.notify_all();
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (unsigned i = 0; (i < threads) && (i < drivers.size()); i++)
+		pool.emplace_back(worker);
+
+	// print results in driver order as they become available
+	std::exception_ptr error;
+	for (std::size_t index = 0; index < drivers.size(); index++)
+	{
+		result current;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			done.wait(lock, [&results, index] () { return results[index].done; });
+			current = std::move(results[index]);
+		}
+		if (current.error)
+		{
+			error = current.error;
+			break;
+		}
+
+		matched++;
+		auto const clone_of = drivlist.clone(drivers[index]);
+		print_summary(
+				current.details.c_str(), current.summary, true,
+				"rom", drivlist.driver(drivers[index]).name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
+				correct, incorrect, notfound);
+	}
+
+	for (std::thread &thread : pool)
+		thread.join();
+	if (error)
+		std::rethrow_exception(error);
+}
+
 } // anonymous namespace
 
 
@@ -237,8 +345,35 @@ void cli_frontend::start_execution(mame_machine_manager *manager, std::vector<st
 	if (!option_errors.empty())
 		osd_printf_error("Error in command line:\n%s\n", strtrimspace(option_errors).c_str());
 
-	// if we can't find it, give an appropriate error
+	// a wildcard with a benchmark report runs every matching system in turn
 	const game_driver *system = mame_options::system(m_options);
+	if (system == nullptr && *(m_options.bench_report()) != 0 && strpbrk(m_options.system_name(), "*?") != nullptr)
+	{
+		std::vector<std::string> names;
+		driver_enumerator drivlist(m_options, m_options.system_name());
+		while (drivlist.next())
+			names.emplace_back(drivlist.driver().name);
+		if (names.empty())
+			throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "No systems matched '%s'", m_options.system_name());
+
+		int failures = 0;
+		for (const std::string &name : names)
+		{
+			osd_printf_info("Benchmarking %s\n", name.c_str());
+			mame_options::set_system_name(m_options, name.c_str());
+			int const result = manager->execute();
+			if (result != EMU_ERR_NONE)
+			{
+				osd_printf_error("%s failed with error %d\n", name.c_str(), result);
+				m_result = result;
+				failures++;
+			}
+		}
+		osd_printf_info("Benchmarked %d systems, %d failed\n", int(names.size()), failures);
+		return;
+	}
+
+	// if we can't find it, give an appropriate error
 	if (system == nullptr && *(m_options.system_name()) != 0)
 		throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "Unknown system '%s'", m_options.system_name());
 
@@ -474,6 +609,20 @@ void cli_frontend::listcrc(const char *gamename)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
+	// use the system information cache if there is one
+	driver_info_cache cache;
+	if (cache.open(m_options, m_options.driver_cache()))
+	{
+		while (drivlist.next())
+			for (const driver_info_cache::rom_info &rom : cache.roms(drivlist.current()))
+			{
+				uint32_t crc;
+				if (util::hash_collection(cache.string(rom.hashdata)).crc(crc))
+					osd_printf_info("%08x %-32s\t%-16s\t%s\n", crc, cache.string(rom.name), cache.string(rom.device_shortname), cache.string(rom.device_name));
+			}
+		return;
+	}
+
 	// iterate through matches, and then through ROMs
 	while (drivlist.next())
 	{
@@ -502,6 +651,37 @@ void cli_frontend::listroms(const char *gamename)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
+	// output one line; disks have no length
+	auto const output_rom = [] (const char *name, int64_t length, const char *hashdata)
+	{
+		// start with the name
+		osd_printf_info("%-32s ", name);
+
+		// output the length next
+		if (length >= 0)
+			osd_printf_info("%10u", unsigned(uint64_t(length)));
+		else
+			osd_printf_info("%10s", "");
+
+		// output the hash data
+		util::hash_collection hashes(hashdata);
+		if (!hashes.flag(util::hash_collection::FLAG_NO_DUMP))
+		{
+			if (hashes.flag(util::hash_collection::FLAG_BAD_DUMP))
+				osd_printf_info(" BAD");
+			osd_printf_info(" %s", hashes.macro_string().c_str());
+		}
+		else
+			osd_printf_info(" NO GOOD DUMP KNOWN");
+
+		// end with a CR
+		osd_printf_info("\n");
+	};
+
+	// use the system information cache if there is one
+	driver_info_cache cache;
+	bool const cached = cache.open(m_options, m_options.driver_cache());
+
 	// iterate through matches
 	bool first = true;
 	while (drivlist.next())
@@ -514,39 +694,25 @@ void cli_frontend::listroms(const char *gamename)
 						"%-32s %10s %s\n",drivlist.driver().name, "Name", "Size", "Checksum");
 
 		// iterate through roms
-		for (device_t &device : device_iterator(drivlist.config()->root_device()))
-			for (const rom_entry *region = rom_first_region(device); region; region = rom_next_region(region))
-				for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
-				{
-					// accumulate the total length of all chunks
-					int64_t length = -1;
-					if (ROMREGION_ISROMDATA(region))
-						length = rom_file_size(rom);
-
-					// start with the name
-					const char *name = ROM_GETNAME(rom);
-					osd_printf_info("%-32s ", name);
-
-					// output the length next
-					if (length >= 0)
-						osd_printf_info("%10u", unsigned(uint64_t(length)));
-					else
-						osd_printf_info("%10s", "");
-
-					// output the hash data
-					util::hash_collection hashes(ROM_GETHASHDATA(rom));
-					if (!hashes.flag(util::hash_collection::FLAG_NO_DUMP))
+		if (cached)
+		{
+			for (const driver_info_cache::rom_info &rom : cache.roms(drivlist.current()))
+				output_rom(cache.string(rom.name), (rom.flags & driver_info_cache::ROM_FLAG_ROMDATA) ? int64_t(rom.length) : -1, cache.string(rom.hashdata));
+		}
+		else
+		{
+			for (device_t &device : device_iterator(drivlist.config()->root_device()))
+				for (const rom_entry *region = rom_first_region(device); region; region = rom_next_region(region))
+					for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
 					{
-						if (hashes.flag(util::hash_collection::FLAG_BAD_DUMP))
-							osd_printf_info(" BAD");
-						osd_printf_info(" %s", hashes.macro_string().c_str());
-					}
-					else
-						osd_printf_info(" NO GOOD DUMP KNOWN");
+						// accumulate the total length of all chunks
+						int64_t length = -1;
+						if (ROMREGION_ISROMDATA(region))
+							length = rom_file_size(rom);
 
-					// end with a CR
-					osd_printf_info("\n");
-				}
+						output_rom(ROM_GETNAME(rom), length, ROM_GETHASHDATA(rom));
+					}
+		}
 	}
 }
 
@@ -601,6 +767,48 @@ void cli_frontend::listdevices(const char *gamename)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
+	// output one device
+	auto const output_device = [] (const char *tag, const char *name, uint32_t clock)
+	{
+		// extract the tag, stripping the leading colon
+		if (*tag == ':')
+			tag++;
+
+		// determine the depth
+		int depth = 1;
+		if (*tag == 0)
+		{
+			tag = "<root>";
+			depth = 0;
+		}
+		else
+		{
+			for (const char *c = tag; *c != 0; c++)
+				if (*c == ':')
+				{
+					tag = c + 1;
+					depth++;
+				}
+		}
+		printf("   %*s%-*s %s", depth * 2, "", 30 - depth * 2, tag, name);
+
+		// add more information
+		if (clock >= 1000000000)
+			printf(" @ %d.%02d GHz\n", clock / 1000000000, (clock / 10000000) % 100);
+		else if (clock >= 1000000)
+			printf(" @ %d.%02d MHz\n", clock / 1000000, (clock / 10000) % 100);
+		else if (clock >= 1000)
+			printf(" @ %d.%02d kHz\n", clock / 1000, (clock / 10) % 100);
+		else if (clock > 0)
+			printf(" @ %d Hz\n", clock);
+		else
+			printf("\n");
+	};
+
+	// use the system information cache if there is one
+	driver_info_cache cache;
+	bool const cached = cache.open(m_options, m_options.driver_cache());
+
 	// iterate over drivers, looking for SAMPLES devices
 	bool first = true;
 	while (drivlist.next())
@@ -611,6 +819,14 @@ void cli_frontend::listdevices(const char *gamename)
 		first = false;
 		printf("Driver %s (%s):\n", drivlist.driver().name, drivlist.driver().description);
 
+		// the cache is already sorted
+		if (cached)
+		{
+			for (const driver_info_cache::device_info &device : cache.devices(drivlist.current()))
+				output_device(cache.string(device.tag), cache.string(device.name), device.clock);
+			continue;
+		}
+
 		// build a list of devices
 		std::vector<device_t *> device_list;
 		for (device_t &device : device_iterator(drivlist.config()->root_device()))
@@ -623,43 +839,7 @@ void cli_frontend::listdevices(const char *gamename)
 
 		// dump the results
 		for (auto device : device_list)
-		{
-			// extract the tag, stripping the leading colon
-			const char *tag = device->tag();
-			if (*tag == ':')
-				tag++;
-
-			// determine the depth
-			int depth = 1;
-			if (*tag == 0)
-			{
-				tag = "<root>";
-				depth = 0;
-			}
-			else
-			{
-				for (const char *c = tag; *c != 0; c++)
-					if (*c == ':')
-					{
-						tag = c + 1;
-						depth++;
-					}
-			}
-			printf("   %*s%-*s %s", depth * 2, "", 30 - depth * 2, tag, device->name());
-
-			// add more information
-			uint32_t clock = device->clock();
-			if (clock >= 1000000000)
-				printf(" @ %d.%02d GHz\n", clock / 1000000000, (clock / 10000000) % 100);
-			else if (clock >= 1000000)
-				printf(" @ %d.%02d MHz\n", clock / 1000000, (clock / 10000) % 100);
-			else if (clock >= 1000)
-				printf(" @ %d.%02d kHz\n", clock / 1000, (clock / 10) % 100);
-			else if (clock > 0)
-				printf(" @ %d Hz\n", clock);
-			else
-				printf("\n");
-		}
+			output_device(device->tag(), device->name(), device->clock());
 	}
 }
 
@@ -734,6 +914,33 @@ void cli_frontend::listmedia(const char *gamename)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
+	// output one image device
+	auto const output_media = [] (const char *system, const char *instance_name, const char *brief_instance_name, const char *file_extensions)
+	{
+		// extract the shortname with parentheses
+		std::string paren_shortname = string_format("(%s)", brief_instance_name);
+
+		// output the line, up to the list of extensions
+		printf("%-16s %-16s %-10s ", system, instance_name, paren_shortname.c_str());
+
+		// get the extensions and print them
+		std::string extensions(file_extensions);
+		for (int start = 0, end = extensions.find_first_of(',');; start = end + 1, end = extensions.find_first_of(',', start))
+		{
+			std::string curext(extensions, start, (end == -1) ? extensions.length() - start : end - start);
+			printf(".%-5s", curext.c_str());
+			if (end == -1)
+				break;
+		}
+
+		// end the line
+		printf("\n");
+	};
+
+	// use the system information cache if there is one
+	driver_info_cache cache;
+	bool const cached = cache.open(m_options, m_options.driver_cache());
+
 	// print header
 	printf("%-16s %-16s %-10s %s\n", "SYSTEM", "MEDIA NAME", "(brief)", "IMAGE FILE EXTENSIONS SUPPORTED");
 	printf("%s %s-%s %s\n", std::string(16,'-').c_str(), std::string(16,'-').c_str(), std::string(10,'-').c_str(), std::string(34,'-').c_str());
@@ -743,30 +950,24 @@ void cli_frontend::listmedia(const char *gamename)
 	{
 		// iterate
 		bool first = true;
-		for (const device_image_interface &imagedev : image_interface_iterator(drivlist.config()->root_device()))
+		if (cached)
 		{
-			if (!imagedev.user_loadable())
-				continue;
-
-			// extract the shortname with parentheses
-			std::string paren_shortname = string_format("(%s)", imagedev.brief_instance_name());
-
-			// output the line, up to the list of extensions
-			printf("%-16s %-16s %-10s ", first ? drivlist.driver().name : "", imagedev.instance_name().c_str(), paren_shortname.c_str());
-
-			// get the extensions and print them
-			std::string extensions(imagedev.file_extensions());
-			for (int start = 0, end = extensions.find_first_of(',');; start = end + 1, end = extensions.find_first_of(',', start))
+			for (const driver_info_cache::media_info &media : cache.media(drivlist.current()))
 			{
-				std::string curext(extensions, start, (end == -1) ? extensions.length() - start : end - start);
-				printf(".%-5s", curext.c_str());
-				if (end == -1)
-					break;
+				output_media(first ? drivlist.driver().name : "", cache.string(media.instance_name), cache.string(media.brief_instance_name), cache.string(media.extensions));
+				first = false;
 			}
+		}
+		else
+		{
+			for (const device_image_interface &imagedev : image_interface_iterator(drivlist.config()->root_device()))
+			{
+				if (!imagedev.user_loadable())
+					continue;
 
-			// end the line
-			printf("\n");
-			first = false;
+				output_media(first ? drivlist.driver().name : "", imagedev.instance_name().c_str(), imagedev.brief_instance_name().c_str(), imagedev.file_extensions());
+				first = false;
+			}
 		}
 
 		// if we didn't get any at all, just print a none line
@@ -789,22 +990,43 @@ void cli_frontend::verifyroms(const char *gamename)
 	unsigned notfound = 0;
 	unsigned matched = 0;
 
+	// remember archive contents and hashes between runs if requested
+	std::unique_ptr<hash_cache> cache;
+	if (*m_options.hash_cache())
+	{
+		cache = std::make_unique<hash_cache>();
+		cache->load(m_options.hash_cache());
+	}
+
+	osd_ticks_t const start = osd_ticks();
+	int threads = m_options.audit_threads();
+	if (threads <= 0)
+		threads = std::max<int>(std::thread::hardware_concurrency(), 1);
+
 	// iterate over drivers
 	media_auditor auditor(drivlist);
+	auditor.set_hash_cache(cache.get());
 	util::ovectorstream summary_string;
-	while (drivlist.next())
+	if (threads > 1)
 	{
-		matched++;
+		audit_drivers_parallel(drivlist, cache.get(), threads, matched, correct, incorrect, notfound);
+	}
+	else
+	{
+		while (drivlist.next())
+		{
+			matched++;
 
-		// audit the ROMs in this set
-		media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+			// audit the ROMs in this set
+			media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
 
-		auto const clone_of = drivlist.clone();
-		print_summary(
-				auditor, summary, true,
-				"rom", drivlist.driver().name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
-				correct, incorrect, notfound,
-				summary_string);
+			auto const clone_of = drivlist.clone();
+			print_summary(
+					auditor, summary, true,
+					"rom", drivlist.driver().name, (clone_of >= 0) ? drivlist.driver(clone_of).name : nullptr,
+					correct, incorrect, notfound,
+					summary_string);
+		}
 	}
 
 	if (!matched || strchr(gamename, '*') || strchr(gamename, '?'))
@@ -901,6 +1123,12 @@ void cli_frontend::verifyroms(const char *gamename)
 
 	// clear out any cached files
 	util::archive_file::cache_clear();
+	if (cache && !cache->save(m_options.hash_cache()))
+		osd_printf_warning("Unable to write hash cache %s\n", m_options.hash_cache());
+
+	// report throughput
+	double const seconds = double(osd_ticks() - start) / double(osd_ticks_per_second());
+	osd_printf_info("%u sets audited in %.2f seconds (%.1f sets/second)\n", matched, seconds, (seconds > 0.0) ? (matched / seconds) : 0.0);
 
 	// return an error if none found
 	if (matched == 0)
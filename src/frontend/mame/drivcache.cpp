@@ -0,0 +1,357 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drivcache.cpp
+
+    Persistent cache of per-system ROM, device and media information.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drivenum.h"
+#include "drivcache.h"
+#include "softlist_dev.h"
+
+#include <algorithm>
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+static const char CACHE_MAGIC[8] = { 'M', 'A', 'M', 'E', 'D', 'R', 'V', 0 };
+static constexpr u32 CACHE_FORMAT = 2;
+static constexpr u32 CACHE_BYTEORDER = 0x01020304;
+
+
+
+//**************************************************************************
+//  DRIVER INFO CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  driver_info_cache - constructor
+//-------------------------------------------------
+
+driver_info_cache::driver_info_cache()
+	: m_drivers(nullptr)
+	, m_roms(nullptr)
+	, m_devices(nullptr)
+	, m_media(nullptr)
+	, m_swlists(nullptr)
+	, m_strings(nullptr)
+	, m_string_bytes(0)
+{
+}
+
+
+//-------------------------------------------------
+//  open - load the cache, rebuilding it from the
+//  machine configurations if it doesn't match
+//  this build
+//-------------------------------------------------
+
+bool driver_info_cache::open(emu_options &options, const char *filename)
+{
+	if (filename == nullptr || *filename == 0)
+		return false;
+	if (load(filename))
+		return true;
+
+	osd_printf_verbose("Building system information cache %s\n", filename);
+	build(options);
+	if (!save(filename))
+		osd_printf_warning("Error saving system information cache %s\n", filename);
+	return valid();
+}
+
+
+//-------------------------------------------------
+//  load - read an image written by save
+//-------------------------------------------------
+
+bool driver_info_cache::load(const char *filename)
+{
+	if (util::core_file::load(filename, m_image) != osd_file::error::NONE)
+		return false;
+	return attach();
+}
+
+
+//-------------------------------------------------
+//  build - gather information from the machine
+//  configuration of every system
+//-------------------------------------------------
+
+void driver_info_cache::build(emu_options &options)
+{
+	std::vector<driver_info> drivers(driver_list::total());
+	std::vector<rom_info> roms;
+	std::vector<device_info> devices;
+	std::vector<media_info> media;
+	std::vector<u32> swlists;
+
+	m_pool.clear();
+	m_pooled.clear();
+	u32 const build = add_string(emulator_info::get_build_version());
+
+	for (int index = 0; index < driver_list::total(); index++)
+	{
+		memset(&drivers[index], 0, sizeof(drivers[index]));
+		drivers[index].name = add_string(driver_list::driver(index).name);
+	}
+
+	driver_enumerator drivlist(options);
+	while (drivlist.next())
+	{
+		driver_info &drv = drivers[drivlist.current()];
+		device_t &root = drivlist.config()->root_device();
+
+		// ROMs, in the order the ROM loader sees them
+		drv.first_rom = roms.size();
+		for (device_t &device : device_iterator(root))
+		{
+			u32 first = ROM_FLAG_FIRST;
+			for (const rom_entry *region = rom_first_region(device); region; region = rom_next_region(region))
+				for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom), first = 0)
+				{
+					rom_info info;
+					info.name = add_string(ROM_GETNAME(rom));
+					info.hashdata = add_string(ROM_GETHASHDATA(rom));
+					info.device_shortname = add_string(device.shortname());
+					info.device_name = add_string(device.name());
+					info.length = ROMREGION_ISROMDATA(region) ? rom_file_size(rom) : 0;
+					info.flags = (ROMREGION_ISROMDATA(region) ? ROM_FLAG_ROMDATA : 0) | ((device.owner() != nullptr) ? ROM_FLAG_DEVICE : 0) | first;
+					roms.push_back(info);
+				}
+		}
+		drv.rom_count = roms.size() - drv.first_rom;
+
+		// devices, sorted by tag
+		std::vector<device_t *> device_list;
+		for (device_t &device : device_iterator(root))
+			device_list.push_back(&device);
+		std::sort(device_list.begin(), device_list.end(), [](device_t *dev1, device_t *dev2) {
+			return strcmp(dev1->tag(), dev2->tag()) < 0;
+		});
+		drv.first_device = devices.size();
+		for (device_t *device : device_list)
+			devices.push_back(device_info{ add_string(device->tag()), add_string(device->name()), device->clock() });
+		drv.device_count = devices.size() - drv.first_device;
+
+		// user-loadable media
+		drv.first_media = media.size();
+		for (const device_image_interface &imagedev : image_interface_iterator(root))
+			if (imagedev.user_loadable())
+				media.push_back(media_info{ add_string(imagedev.instance_name().c_str()), add_string(imagedev.brief_instance_name().c_str()), add_string(imagedev.file_extensions()) });
+		drv.media_count = media.size() - drv.first_media;
+
+		// software lists
+		drv.first_swlist = swlists.size();
+		for (software_list_device &swlistdev : software_list_device_iterator(root))
+			swlists.push_back(add_string(swlistdev.list_name().c_str()));
+		drv.swlist_count = swlists.size() - drv.first_swlist;
+	}
+
+	// lay out the image
+	header head;
+	memcpy(head.magic, CACHE_MAGIC, sizeof(head.magic));
+	head.format = CACHE_FORMAT;
+	head.byteorder = CACHE_BYTEORDER;
+	head.build = build;
+	head.checksum = driver_checksum();
+	head.drivers = drivers.size();
+	head.roms = roms.size();
+	head.devices = devices.size();
+	head.media = media.size();
+	head.swlists = swlists.size();
+	head.strings = m_pool.size();
+
+	m_image.clear();
+	auto append = [this] (const void *data, std::size_t length)
+	{
+		const u8 *const bytes = reinterpret_cast<const u8 *>(data);
+		m_image.insert(m_image.end(), bytes, bytes + length);
+	};
+	append(&head, sizeof(head));
+	append(drivers.data(), drivers.size() * sizeof(driver_info));
+	append(roms.data(), roms.size() * sizeof(rom_info));
+	append(devices.data(), devices.size() * sizeof(device_info));
+	append(media.data(), media.size() * sizeof(media_info));
+	append(swlists.data(), swlists.size() * sizeof(u32));
+	append(m_pool.data(), m_pool.size());
+
+	m_pool.clear();
+	m_pooled.clear();
+	attach();
+}
+
+
+//-------------------------------------------------
+//  save - write the image out
+//-------------------------------------------------
+
+bool driver_info_cache::save(const char *filename) const
+{
+	if (!valid())
+		return false;
+
+	util::core_file::ptr file;
+	if (util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file) != osd_file::error::NONE)
+		return false;
+	return file->write(m_image.data(), m_image.size()) == m_image.size();
+}
+
+
+//-------------------------------------------------
+//  attach - check the image belongs to this build
+//  and point the tables into it
+//-------------------------------------------------
+
+bool driver_info_cache::attach()
+{
+	m_drivers = nullptr;
+
+	// check the header
+	if (m_image.size() < sizeof(header))
+		return false;
+	header head;
+	memcpy(&head, m_image.data(), sizeof(head));
+	if (memcmp(head.magic, CACHE_MAGIC, sizeof(head.magic)) || head.format != CACHE_FORMAT || head.byteorder != CACHE_BYTEORDER)
+		return false;
+	if (head.drivers != driver_list::total())
+		return false;
+
+	// check the sizes add up
+	u64 const expected = u64(sizeof(header))
+			+ u64(head.drivers) * sizeof(driver_info)
+			+ u64(head.roms) * sizeof(rom_info)
+			+ u64(head.devices) * sizeof(device_info)
+			+ u64(head.media) * sizeof(media_info)
+			+ u64(head.swlists) * sizeof(u32)
+			+ head.strings;
+	if (m_image.size() != expected || head.strings == 0 || m_image.back() != 0)
+		return false;
+
+	// point at the tables
+	const u8 *ptr = m_image.data() + sizeof(header);
+	const driver_info *const drivers = reinterpret_cast<const driver_info *>(ptr);
+	ptr += head.drivers * sizeof(driver_info);
+	m_roms = reinterpret_cast<const rom_info *>(ptr);
+	ptr += head.roms * sizeof(rom_info);
+	m_devices = reinterpret_cast<const device_info *>(ptr);
+	ptr += head.devices * sizeof(device_info);
+	m_media = reinterpret_cast<const media_info *>(ptr);
+	ptr += head.media * sizeof(media_info);
+	m_swlists = reinterpret_cast<const u32 *>(ptr);
+	ptr += head.swlists * sizeof(u32);
+	m_strings = reinterpret_cast<const char *>(ptr);
+
+	m_string_bytes = head.strings;
+
+	// a different build or changed system definitions invalidate everything
+	if (!valid_string(head.build) || strcmp(string(head.build), emulator_info::get_build_version()))
+		return false;
+	if (head.checksum != driver_checksum())
+		return false;
+
+	// make sure the systems line up and the records stay in bounds
+	for (int index = 0; index < head.drivers; index++)
+	{
+		const driver_info &drv = drivers[index];
+		if (!valid_string(drv.name) || strcmp(string(drv.name), driver_list::driver(index).name))
+			return false;
+		if (u64(drv.first_rom) + drv.rom_count > head.roms || u64(drv.first_device) + drv.device_count > head.devices
+				|| u64(drv.first_media) + drv.media_count > head.media || u64(drv.first_swlist) + drv.swlist_count > head.swlists)
+			return false;
+	}
+
+	// every string reference has to land in the pool
+	for (const rom_info &rom : range<rom_info>(m_roms, m_roms + head.roms))
+		if (!valid_string(rom.name) || !valid_string(rom.hashdata) || !valid_string(rom.device_shortname) || !valid_string(rom.device_name))
+			return false;
+	for (const device_info &device : range<device_info>(m_devices, m_devices + head.devices))
+		if (!valid_string(device.tag) || !valid_string(device.name))
+			return false;
+	for (const media_info &media : range<media_info>(m_media, m_media + head.media))
+		if (!valid_string(media.instance_name) || !valid_string(media.brief_instance_name) || !valid_string(media.extensions))
+			return false;
+	for (u32 swlist : range<u32>(m_swlists, m_swlists + head.swlists))
+		if (!valid_string(swlist))
+			return false;
+
+	m_drivers = drivers;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  valid_string - check a string offset is inside
+//  the pool; the pool ends with a terminator, so
+//  any offset inside it gives a bounded string
+//-------------------------------------------------
+
+bool driver_info_cache::valid_string(u32 offset) const
+{
+	return offset < m_string_bytes;
+}
+
+
+//-------------------------------------------------
+//  driver_checksum - checksum the system list and
+//  the ROM definitions of every system, so a
+//  development build with changed ROMs or systems
+//  doesn't reuse a stale cache; devices can't be
+//  reached without a machine configuration, so
+//  changes to those still need a new build version
+//-------------------------------------------------
+
+u32 driver_info_cache::driver_checksum()
+{
+	util::crc32_creator crc;
+	auto const append_string = [&crc] (const char *string)
+	{
+		if (string == nullptr)
+			string = "";
+		crc.append(string, strlen(string) + 1);
+	};
+	auto const append_u32 = [&crc] (u32 value)
+	{
+		crc.append(&value, sizeof(value));
+	};
+
+	for (int index = 0; index < driver_list::total(); index++)
+	{
+		game_driver const &driver = driver_list::driver(index);
+		append_string(driver.name);
+		append_string(driver.parent);
+		append_string(driver.source_file);
+		append_u32(driver.flags);
+		for (const tiny_rom_entry *rom = driver.rom; rom != nullptr; rom++)
+		{
+			append_string(rom->name);
+			append_string(rom->hashdata);
+			append_u32(rom->offset);
+			append_u32(rom->length);
+			append_u32(rom->flags);
+			if ((rom->flags & ROMENTRY_TYPEMASK) == ROMENTRYTYPE_END)
+				break;
+		}
+	}
+	return crc.finish();
+}
+
+
+//-------------------------------------------------
+//  add_string - add a string to the pool, sharing
+//  storage with identical strings
+//-------------------------------------------------
+
+u32 driver_info_cache::add_string(const char *string)
+{
+	auto const found = m_pooled.emplace(string ? string : "", u32(m_pool.size()));
+	if (found.second)
+		m_pool.append(found.first->first).push_back(0);
+	return found.first->second;
+}
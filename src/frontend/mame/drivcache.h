@@ -0,0 +1,140 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drivcache.h
+
+    Persistent cache of per-system ROM, device and media information.
+
+***************************************************************************/
+#ifndef MAME_FRONTEND_DRIVCACHE_H
+#define MAME_FRONTEND_DRIVCACHE_H
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> driver_info_cache
+
+// driver_info_cache holds the information list commands need about every
+// system in a single flat image, so they don't have to instantiate a
+// machine_config per system; the image is only valid for the build and
+// system ROM definitions that produced it and is rebuilt when they change
+class driver_info_cache
+{
+public:
+	// ROM flags
+	static constexpr u32 ROM_FLAG_ROMDATA = 0x01;   // ROM is in a ROM data region rather than a disk region
+	static constexpr u32 ROM_FLAG_DEVICE  = 0x02;   // ROM belongs to a device rather than the system itself
+	static constexpr u32 ROM_FLAG_FIRST   = 0x04;   // first ROM of a device
+
+	// records; all strings are offsets into the string pool
+	struct driver_info
+	{
+		u32             name;
+		u32             first_rom, rom_count;
+		u32             first_device, device_count;
+		u32             first_media, media_count;
+		u32             first_swlist, swlist_count;
+	};
+
+	struct rom_info
+	{
+		u32             name;
+		u32             hashdata;
+		u32             device_shortname;
+		u32             device_name;
+		u32             length;
+		u32             flags;
+	};
+
+	struct device_info
+	{
+		u32             tag;                        // full tag, sorted within each system
+		u32             name;
+		u32             clock;
+	};
+
+	struct media_info
+	{
+		u32             instance_name;
+		u32             brief_instance_name;
+		u32             extensions;
+	};
+
+	// a run of records belonging to one system
+	template <typename T>
+	class range
+	{
+	public:
+		range(const T *begin, const T *end) : m_begin(begin), m_end(end) { }
+		const T *begin() const { return m_begin; }
+		const T *end() const { return m_end; }
+		bool empty() const { return m_begin == m_end; }
+	private:
+		const T *m_begin, *m_end;
+	};
+
+	// construction/destruction
+	driver_info_cache();
+
+	// load the cache or rebuild it if it is missing or stale
+	bool open(emu_options &options, const char *filename);
+
+	// getters
+	bool valid() const { return m_drivers != nullptr; }
+	const char *string(u32 offset) const { return m_strings + offset; }
+	range<rom_info> roms(int driver) const { const driver_info &drv = m_drivers[driver]; return range<rom_info>(m_roms + drv.first_rom, m_roms + drv.first_rom + drv.rom_count); }
+	range<device_info> devices(int driver) const { const driver_info &drv = m_drivers[driver]; return range<device_info>(m_devices + drv.first_device, m_devices + drv.first_device + drv.device_count); }
+	range<media_info> media(int driver) const { const driver_info &drv = m_drivers[driver]; return range<media_info>(m_media + drv.first_media, m_media + drv.first_media + drv.media_count); }
+	range<u32> software_lists(int driver) const { const driver_info &drv = m_drivers[driver]; return range<u32>(m_swlists + drv.first_swlist, m_swlists + drv.first_swlist + drv.swlist_count); }
+
+private:
+	struct header
+	{
+		char            magic[8];
+		u32             format;
+		u32             byteorder;
+		u32             build;                      // string offset of the build version
+		u32             checksum;                   // checksum of the system list and system ROMs
+		u32             drivers;
+		u32             roms;
+		u32             devices;
+		u32             media;
+		u32             swlists;
+		u32             strings;                    // bytes in the string pool
+	};
+
+	// internal helpers
+	bool load(const char *filename);
+	void build(emu_options &options);
+	bool save(const char *filename) const;
+	bool attach();
+	bool valid_string(u32 offset) const;
+	static u32 driver_checksum();
+	u32 add_string(const char *string);
+
+	// the image, laid out as header, drivers, ROMs, devices, media, software lists, strings
+	std::vector<u8>                         m_image;
+	const driver_info *                     m_drivers;
+	const rom_info *                        m_roms;
+	const device_info *                     m_devices;
+	const media_info *                      m_media;
+	const u32 *                             m_swlists;
+	const char *                            m_strings;
+	u32                                     m_string_bytes;
+
+	// string pool used while building
+	std::string                             m_pool;
+	std::unordered_map<std::string, u32>    m_pooled;
+};
+
+
+#endif  // MAME_FRONTEND_DRIVCACHE_H
@@ -514,6 +514,8 @@ void lua_engine::share_write(memory_share &share, offs_t address, T val)
 lua_engine::lua_engine()
 {
 	m_machine = nullptr;
+	m_frame_budget = 0;
+	m_frame_spent = 0;
 	m_lua_state = luaL_newstate();  /* create state */
 	m_sol_state = new sol::state_view(m_lua_state); // create sol view
 
@@ -603,35 +605,99 @@ bool lua_engine::menu_callback(const std::string &menu, int index, const std::st
 	return ret;
 }
 
+//-------------------------------------------------
+//  execute_function - run the callbacks on a hook;
+//  deferrable ones only run while the frame budget
+//  lasts, taking turns so none of them starve
+//-------------------------------------------------
+
 bool lua_engine::execute_function(const char *id)
 {
-	sol::object functable = sol().registry()[id];
-	if(functable.is<sol::table>())
+	auto found = m_hooks.find(id);
+	if(found == m_hooks.end())
+		return false;
+	hook &h = found->second;
+
+	// callbacks may register more callbacks, so only hold indices across calls
+	size_t const count = h.callbacks.size();
+	for(size_t index = 0; index < count; index++)
+		if(!h.callbacks[index].deferrable)
+			run_callback(h.callbacks, index);
+
+	size_t next = h.next_deferrable;
+	for(size_t i = 0; i < count; i++)
 	{
-		for(auto &func : functable.as<sol::table>())
+		size_t const index = (h.next_deferrable + i) % count;
+		if(!h.callbacks[index].deferrable)
+			continue;
+		if(m_frame_budget != 0 && m_frame_spent >= m_frame_budget)
+			h.callbacks[index].deferred++;
+		else
 		{
-			if(func.second.is<sol::protected_function>())
-			{
-				auto ret = (func.second.as<sol::protected_function>())();
-				if(!ret.valid())
-				{
-					sol::error err = ret;
-					osd_printf_error("[LUA ERROR] in execute_function: %s\n", err.what());
-				}
-			}
+			run_callback(h.callbacks, index);
+			next = (index + 1) % count;
 		}
-		return true;
 	}
-	return false;
+	h.next_deferrable = next;
+	return true;
 }
 
-void lua_engine::register_function(sol::function func, const char *id)
+void lua_engine::run_callback(std::vector<hook_callback> &callbacks, size_t index)
 {
-	sol::object functable = sol().registry()[id];
-	if(functable.is<sol::table>())
-		functable.as<sol::table>().add(func);
+	sol::protected_function func = callbacks[index].func;
+	osd_ticks_t const start = osd_ticks();
+	auto ret = func();
+	if(!ret.valid())
+	{
+		sol::error err = ret;
+		osd_printf_error("[LUA ERROR] in execute_function: %s\n", err.what());
+	}
+	osd_ticks_t const elapsed = osd_ticks() - start;
+	hook_callback &callback = callbacks[index];
+	callback.calls++;
+	callback.last = elapsed;
+	callback.total += elapsed;
+	callback.peak = std::max(callback.peak, elapsed);
+	m_frame_spent += elapsed;
+}
+
+std::string lua_engine::register_function(sol::function func, const char *id, sol::object name, sol::object deferrable)
+{
+	hook &h = m_hooks[id];
+	hook_callback callback;
+	callback.func = func;
+
+	// unnamed callbacks are named after where they were defined, which
+	// tells plugins apart; callback_stats is keyed by name, so number any
+	// repeats
+	std::string base;
+	if(name.is<const char *>())
+		base = name.as<const char *>();
 	else
-		sol().registry().create_named(id, 1, func);
+	{
+		lua_Debug ar;
+		func.push(m_lua_state);
+		if(lua_getinfo(m_lua_state, ">S", &ar) && (ar.linedefined > 0))
+			base = string_format("%s:%d", ar.short_src, ar.linedefined);
+		else
+			base = string_format("%s %d", id, int(h.callbacks.size() + 1));
+	}
+	auto const taken = [this](const std::string &candidate)
+	{
+		for(auto &other : m_hooks)
+			for(hook_callback &registered : other.second.callbacks)
+				if(registered.name == candidate)
+					return true;
+		return false;
+	};
+	callback.name = base;
+	for(int suffix = 2; taken(callback.name); suffix++)
+		callback.name = string_format("%s #%d", base, suffix);
+	callback.deferrable = deferrable.is<bool>() && deferrable.as<bool>();
+	callback.total = callback.last = callback.peak = 0;
+	callback.calls = callback.deferred = 0;
+	h.callbacks.push_back(std::move(callback));
+	return h.callbacks.back().name;
 }
 
 void lua_engine::on_machine_prestart()
@@ -662,6 +728,10 @@ void lua_engine::on_machine_resume()
 void lua_engine::on_machine_frame()
 {
 	execute_function("LUA_ON_FRAME");
+
+	// the frame callbacks run last in each video frame update, after the
+	// frame done and periodic ones, so start the next frame's budget here
+	m_frame_spent = 0;
 }
 
 void lua_engine::on_frame_done()
@@ -706,9 +776,16 @@ void lua_engine::initialize()
  * emu.register_stop(callback) - callback after stopping
  * emu.register_pause(callback) - callback at pause
  * emu.register_resume(callback) - callback at resume
- * emu.register_frame(callback) - callback at end of frame
- * emu.register_frame_done(callback) - callback after frame is drawn to screen (for overlays)
- * emu.register_periodic(callback) - periodic callback while program is running
+ * emu.register_frame(callback, [opt] name, [opt] deferrable) - callback at end of frame, returns the name used in callback_stats
+ * emu.register_frame_done(callback, [opt] name, [opt] deferrable) - callback after frame is drawn to screen (for overlays), returns the name used in callback_stats
+ * emu.register_periodic(callback, [opt] name, [opt] deferrable) - periodic callback while program is running, returns the name used in callback_stats
+ * emu.set_frame_budget(seconds) - host time deferrable callbacks may use per frame before the rest wait for a later frame, 0 for no limit;
+   frame done, periodic and frame callbacks all share it, and it restarts after the frame callbacks (periodic callbacks
+   run while the debugger is stopped count against the next frame)
+ * emu.callback_stats() - table of registered callbacks by name with calls, deferred, and total, last and peak host time in seconds;
+   an unnamed callback is named after the source file and line that define it, and a name registered more than once
+   gets " #2", " #3" and so on appended
+   (work too slow for any budget can go to an emu.thread and report back through thread.result)
  * emu.register_menu(event_callback, populate_callback, name) - callbacks for plugin menu
  * emu.print_verbose(str) -- output to stderr at verbose level
  * emu.print_error(str) -- output to stderr at error level
@@ -740,9 +817,26 @@ void lua_engine::initialize()
 	emu["register_stop"] = [this](sol::function func){ register_function(func, "LUA_ON_STOP"); };
 	emu["register_pause"] = [this](sol::function func){ register_function(func, "LUA_ON_PAUSE"); };
 	emu["register_resume"] = [this](sol::function func){ register_function(func, "LUA_ON_RESUME"); };
-	emu["register_frame"] = [this](sol::function func){ register_function(func, "LUA_ON_FRAME"); };
-	emu["register_frame_done"] = [this](sol::function func){ register_function(func, "LUA_ON_FRAME_DONE"); };
-	emu["register_periodic"] = [this](sol::function func){ register_function(func, "LUA_ON_PERIODIC"); };
+	emu["register_frame"] = [this](sol::function func, sol::object name, sol::object deferrable){ return register_function(func, "LUA_ON_FRAME", name, deferrable); };
+	emu["register_frame_done"] = [this](sol::function func, sol::object name, sol::object deferrable){ return register_function(func, "LUA_ON_FRAME_DONE", name, deferrable); };
+	emu["register_periodic"] = [this](sol::function func, sol::object name, sol::object deferrable){ return register_function(func, "LUA_ON_PERIODIC", name, deferrable); };
+	emu["set_frame_budget"] = [this](double seconds){ m_frame_budget = osd_ticks_t(std::max(seconds, 0.0) * osd_ticks_per_second()); };
+	emu["callback_stats"] = [this](){
+			sol::table stats = sol().create_table();
+			double const tps = osd_ticks_per_second();
+			for(auto &h : m_hooks)
+				for(hook_callback &callback : h.second.callbacks)
+				{
+					sol::table entry = sol().create_table();
+					entry["calls"] = callback.calls;
+					entry["deferred"] = callback.deferred;
+					entry["total"] = callback.total / tps;
+					entry["last"] = callback.last / tps;
+					entry["peak"] = callback.peak / tps;
+					stats[callback.name] = entry;
+				}
+			return stats;
+		};
 	emu["register_menu"] = [this](sol::function cb, sol::function pop, const std::string &name) {
 			std::string cbfield = "menu_cb_" + name;
 			std::string popfield = "menu_pop_" + name;
@@ -1190,6 +1284,23 @@ void lua_engine::initialize()
 			"write_direct_u32", &addr_space::direct_mem_write<uint32_t>,
 			"write_direct_i64", &addr_space::direct_mem_write<int64_t>,
 			"write_direct_u64", &addr_space::direct_mem_write<uint64_t>,
+			// block transfers go through the memory system a byte at a time but
+			// cross into lua once: space:read_block(addr, len) returns a string,
+			// space:write_block(addr, str) writes one
+			"read_block", [](addr_space &sp, offs_t address, sol::buffer *buff) {
+					address_space &space = sp.space;
+					offs_t byteaddress = space.address_to_byte(address);
+					char *ptr = buff->get_ptr();
+					for(int i = 0; i < buff->get_len(); i++)
+						ptr[i] = space.read_byte(byteaddress + i);
+					return buff;
+				},
+			"write_block", [](addr_space &sp, offs_t address, const std::string &data) {
+					address_space &space = sp.space;
+					offs_t byteaddress = space.address_to_byte(address);
+					for(size_t i = 0; i < data.length(); i++)
+						space.write_byte(byteaddress + i, data[i]);
+				},
 			"name", sol::property(&addr_space::name),
 			"map", sol::property([this](addr_space &sp) {
 					address_space &space = sp.space;
@@ -1227,6 +1338,7 @@ void lua_engine::initialize()
  * port:read() - get port value
  * port:write(val, mask) - set port to value & mask (output fields only, for other fields use field:set_value(val))
  * port:field(mask) - get ioport_field for port and mask
+ * port:set_fields(table) - set the value of each field named in table, e.g. { ["P1 Button 1"] = 1 }
  * port.field[] - get ioport_field table
  */
 
@@ -1237,6 +1349,16 @@ void lua_engine::initialize()
 			"read", &ioport_port::read,
 			"write", &ioport_port::write,
 			"field", &ioport_port::field,
+			"set_fields", [](ioport_port &p, sol::table values) {
+					for(ioport_field &field : p.fields())
+					{
+						if (field.type_class() == INPUT_CLASS_INTERNAL)
+							continue;
+						sol::object value = values[field.name()];
+						if(value.is<ioport_value>())
+							field.set_value(value.as<ioport_value>());
+					}
+				},
 			"fields", sol::property([this](ioport_port &p){
 					sol::table f_table = sol().create_table();
 					for(ioport_field &field : p.fields())
@@ -1417,6 +1539,7 @@ void lua_engine::initialize()
  * screen:orientation() - screen angle, flipx, flipy
  * screen:refresh() - screen refresh rate
  * screen:snapshot() - save snap shot
+ * screen:pixels() - get the screen as rendered for a snapshot: a string of 32-bit ARGB pixels, width, height
  * screen:type() - screen drawing type
  * screen:frame_number() - screen frame count
  * screen:name() - screen device full name
@@ -1519,6 +1642,14 @@ void lua_engine::initialize()
 					machine().video().save_snapshot(&sdev, file);
 					return sol::make_object(sol(), sol::nil);
 				},
+			"pixels", [this](screen_device &sdev) {
+					const bitmap_rgb32 &bitmap = machine().video().snapshot_bitmap(&sdev);
+					std::string pixels;
+					pixels.reserve(bitmap.width() * bitmap.height() * sizeof(uint32_t));
+					for(int y = 0; y < bitmap.height(); y++)
+						pixels.append((const char *)&bitmap.pix32(y), bitmap.width() * sizeof(uint32_t));
+					return std::make_tuple(pixels, bitmap.width(), bitmap.height());
+				},
 			"type", [](screen_device &sdev) {
 					switch (sdev.screen_type())
 					{
@@ -1711,6 +1842,7 @@ bool lua_engine::frame_hook()
 
 void lua_engine::close()
 {
+	m_hooks.clear();
 	lua_settop(m_lua_state, 0);  /* clear stack */
 	lua_close(m_lua_state);
 }
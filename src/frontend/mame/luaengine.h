@@ -120,9 +120,33 @@ private:
 	void on_machine_resume();
 	void on_machine_frame();
 
+	// a callback registered on one of the emu.register_* hooks, with the
+	// host time it has used
+	struct hook_callback
+	{
+		sol::protected_function func;
+		std::string name;
+		bool deferrable;            // may be skipped when the frame budget is spent
+		osd_ticks_t total, last, peak;
+		u64 calls, deferred;
+	};
+
+	struct hook
+	{
+		hook() : next_deferrable(0) { }
+
+		std::vector<hook_callback> callbacks;
+		size_t next_deferrable;     // where the next frame's deferrable callbacks start
+	};
+
+	std::map<std::string, hook> m_hooks;
+	osd_ticks_t m_frame_budget;     // host ticks deferrable callbacks may use per frame, 0 for no limit
+	osd_ticks_t m_frame_spent;      // host ticks used by callbacks since the last frame callbacks ran
+
 	void resume(void *ptr, int nparam);
-	void register_function(sol::function func, const char *id);
+	std::string register_function(sol::function func, const char *id, sol::object name = sol::nil, sol::object deferrable = sol::nil);
 	bool execute_function(const char *id);
+	void run_callback(std::vector<hook_callback> &callbacks, size_t index);
 	sol::object call_plugin(const std::string &name, sol::object in);
 
 	struct addr_space {
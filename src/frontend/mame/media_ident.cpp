@@ -10,6 +10,7 @@
 
 #include "emu.h"
 #include "drivenum.h"
+#include "emuopts.h"
 #include "media_ident.h"
 #include "unzip.h"
 #include "jedparse.h"
@@ -26,10 +27,12 @@
 
 media_identifier::media_identifier(emu_options &options)
 	: m_drivlist(options),
+		m_cached(false),
 		m_total(0),
 		m_matches(0),
 		m_nonroms(0)
 {
+	m_cached = m_cache.open(options, options.driver_cache());
 }
 
 
@@ -219,28 +222,64 @@ int media_identifier::find_by_hash(const util::hash_collection &hashes, int leng
 	m_drivlist.reset();
 	while (m_drivlist.next())
 	{
-		// iterate over devices, regions and files within the region
-		for (device_t &device : device_iterator(m_drivlist.config()->root_device()))
+		// the cache has the ROMs of each device in a run, like the loop below
+		if (m_cached)
 		{
-			if (shortnames.insert(device.shortname()).second)
+			bool newdevice = false;
+			for (const driver_info_cache::rom_info &rom : m_cache.roms(m_drivlist.current()))
 			{
-				for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
-					for (const rom_entry *rom = rom_first_file(region); rom != nullptr; rom = rom_next_file(rom))
-					{
-						util::hash_collection romhashes(ROM_GETHASHDATA(rom));
-						if (!romhashes.flag(util::hash_collection::FLAG_NO_DUMP) && hashes == romhashes)
+				if (rom.flags & driver_info_cache::ROM_FLAG_FIRST)
+					newdevice = shortnames.insert(m_cache.string(rom.device_shortname)).second;
+				if (!newdevice)
+					continue;
+
+				util::hash_collection romhashes(m_cache.string(rom.hashdata));
+				if (!romhashes.flag(util::hash_collection::FLAG_NO_DUMP) && hashes == romhashes)
+				{
+					bool baddump = romhashes.flag(util::hash_collection::FLAG_BAD_DUMP);
+
+					// output information about the match
+					if (found)
+						osd_printf_info("                    ");
+					osd_printf_info("= %s%-20s  %-10s %s%s\n", baddump ? "(BAD) " : "",
+						m_cache.string(rom.name), m_cache.string(rom.device_shortname), m_cache.string(rom.device_name),
+						(rom.flags & driver_info_cache::ROM_FLAG_DEVICE) ? " (device)" : "");
+					found++;
+				}
+			}
+
+			// only build the configuration if there's a software list we haven't seen
+			bool newlist = false;
+			for (u32 listname : m_cache.software_lists(m_drivlist.current()))
+				newlist = newlist || (listnames.find(m_cache.string(listname)) == listnames.end());
+			if (!newlist)
+				continue;
+		}
+		else
+		{
+			// iterate over devices, regions and files within the region
+			for (device_t &device : device_iterator(m_drivlist.config()->root_device()))
+			{
+				if (shortnames.insert(device.shortname()).second)
+				{
+					for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
+						for (const rom_entry *rom = rom_first_file(region); rom != nullptr; rom = rom_next_file(rom))
 						{
-							bool baddump = romhashes.flag(util::hash_collection::FLAG_BAD_DUMP);
-
-							// output information about the match
-							if (found)
-								osd_printf_info("                    ");
-							osd_printf_info("= %s%-20s  %-10s %s%s\n", baddump ? "(BAD) " : "",
-								ROM_GETNAME(rom), device.shortname(), device.name(),
-								device.owner() != nullptr ? " (device)" : "");
-							found++;
+							util::hash_collection romhashes(ROM_GETHASHDATA(rom));
+							if (!romhashes.flag(util::hash_collection::FLAG_NO_DUMP) && hashes == romhashes)
+							{
+								bool baddump = romhashes.flag(util::hash_collection::FLAG_BAD_DUMP);
+
+								// output information about the match
+								if (found)
+									osd_printf_info("                    ");
+								osd_printf_info("= %s%-20s  %-10s %s%s\n", baddump ? "(BAD) " : "",
+									ROM_GETNAME(rom), device.shortname(), device.name(),
+									device.owner() != nullptr ? " (device)" : "");
+								found++;
+							}
 						}
-					}
+				}
 			}
 		}
 
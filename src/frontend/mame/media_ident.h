@@ -10,6 +10,8 @@
 #ifndef MAME_FRONTEND_MEDIA_IDENT_H
 #define MAME_FRONTEND_MEDIA_IDENT_H
 
+#include "drivcache.h"
+
 // media_identifier class identifies media by hash via a search in
 // the driver database
 class media_identifier
@@ -33,6 +35,8 @@ public:
 private:
 	// internal state
 	driver_enumerator   m_drivlist;
+	driver_info_cache   m_cache;
+	bool                m_cached;
 	int                 m_total;
 	int                 m_matches;
 	int                 m_nonroms;
@@ -158,6 +158,10 @@ void menu_cheat::populate(float &customtop, float &custombottom)
 
 		/* add a reload all cheats option */
 		item_append(_("Reload All"), "", 0, (void *)ITEMREF_CHEATS_RELOAD_ALL);
+
+		/* show what the running cheats cost */
+		double const ms = double(mame_machine_manager::instance()->cheat().average_frame_ticks()) * 1000.0 / double(osd_ticks_per_second());
+		item_append(_("Cheat Time"), string_format(_("%1$.3f ms/frame"), ms), FLAG_DISABLE, nullptr);
 	}
 }
 
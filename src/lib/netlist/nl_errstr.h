@@ -42,6 +42,7 @@
 #define MF_1_NETGROUP_SIZE_EXCEEDED_1           "Encountered netgroup with > {1} nets"
 
 #define MW_1_NO_SPECIFIC_SOLVER                 "No specific solver found for netlist of size {1}"
+#define MW_0_PARALLEL_DYNAMIC_TS                "PARALLEL is ignored with DYNAMIC_TS, solving serially"
 
 // nl_base.cpp
 
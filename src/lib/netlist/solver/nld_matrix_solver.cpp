@@ -84,6 +84,7 @@ matrix_solver_t::matrix_solver_t(netlist_t &anetlist, const pstring &name,
 	, m_iterative_fail(*this, "m_iterative_fail", 0)
 	, m_iterative_total(*this, "m_iterative_total", 0)
 	, m_last_step(*this, "m_last_step", netlist_time::zero())
+	, m_resched_pending(false)
 	, m_fb_sync(*this, "FB_sync")
 	, m_Q_sync(*this, "Q_sync")
 	, m_sort(sort)
@@ -356,6 +357,18 @@ void matrix_solver_t::setup_matrix()
 
 void matrix_solver_t::update_inputs()
 {
+	/* solve_base may run on a worker thread and must not touch the queue.
+	 * Rescheduling after exceeded newton loops is therefore done here.
+	 */
+	if (m_resched_pending)
+	{
+		m_resched_pending = false;
+		if (!m_Q_sync.net().is_queued())
+		{
+			log().warning(MW_1_NEWTON_LOOPS_EXCEEDED_ON_NET_1, this->name());
+			m_Q_sync.net().toggle_and_push_to_queue(m_params.m_nr_recalc_delay);
+		}
+	}
 	// avoid recursive calls. Inputs are updated outside this call
 	for (auto &inp : m_inps)
 		inp->push(inp->m_proxied_net->Q_Analog());
@@ -418,12 +431,8 @@ void matrix_solver_t::solve_base()
 		} while (this_resched > 1 && newton_loops < m_params.m_nr_loops);
 
 		m_stat_newton_raphson += newton_loops;
-		// reschedule ....
-		if (this_resched > 1 && !m_Q_sync.net().is_queued())
-		{
-			log().warning(MW_1_NEWTON_LOOPS_EXCEEDED_ON_NET_1, this->name());
-			m_Q_sync.net().toggle_and_push_to_queue(m_params.m_nr_recalc_delay);
-		}
+		// reschedule .... done in update_inputs
+		m_resched_pending = (this_resched > 1);
 	}
 	else
 	{
@@ -112,10 +112,13 @@ public:
 
 	/* after every call to solve, update inputs must be called.
 	 * this can be done as well as a batch to ease parallel processing.
+	 * solve only touches state owned by this solver and may be called
+	 * from a worker thread; update_inputs must run on the netlist thread.
 	 */
 	const netlist_time solve();
 	void update_inputs();
 
+	inline std::size_t net_count() const { return m_nets.size(); }
 	inline bool has_dynamic_devices() const { return m_dynamic_devices.size() > 0; }
 	inline bool has_timestep_devices() const { return m_step_devices.size() > 0; }
 
@@ -180,6 +183,7 @@ protected:
 private:
 
 	state_var<netlist_time> m_last_step;
+	bool m_resched_pending;
 	std::vector<core_device_t *> m_step_devices;
 	std::vector<core_device_t *> m_dynamic_devices;
 
@@ -101,6 +101,8 @@ private:
 	nl_ext_double m_lA[storage_N][m_pitch];
 	nl_ext_double m_lAinv[storage_N][m_pitch];
 
+	unsigned m_cnt;
+
 	//nl_ext_double m_RHSx[storage_N];
 
 	const std::size_t m_dim;
@@ -219,12 +221,11 @@ template <std::size_t m_N, std::size_t storage_N>
 unsigned matrix_solver_sm_t<m_N, storage_N>::solve_non_dynamic(const bool newton_raphson)
 {
 	static const bool incremental = true;
-	static unsigned cnt = 0;
 	const auto iN = N();
 
 	nl_double new_V[storage_N]; // = { 0.0 };
 
-	if (0 || ((cnt % 200) == 0))
+	if (0 || ((m_cnt % 200) == 0))
 	{
 		/* complete calculation */
 		this->LE_invert();
@@ -286,7 +287,7 @@ unsigned matrix_solver_sm_t<m_N, storage_N>::solve_non_dynamic(const bool newton
 		}
 	}
 
-	cnt++;
+	m_cnt++;
 
 	this->LE_compute_x(new_V);
 
@@ -322,6 +323,7 @@ template <std::size_t m_N, std::size_t storage_N>
 matrix_solver_sm_t<m_N, storage_N>::matrix_solver_sm_t(netlist_t &anetlist, const pstring &name,
 		const solver_parameters_t *params, const std::size_t size)
 : matrix_solver_t(anetlist, name, NOSORT, params)
+, m_cnt(0)
 , m_dim(size)
 {
 	for (std::size_t k = 0; k < N(); k++)
@@ -32,13 +32,13 @@
 
 #include <algorithm>
 #include <cmath>  // <<= needed by windows build
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "../nl_lists.h"
 
-#if HAS_OPENMP
-#include "omp.h"
-#endif
-
 #include "../nl_factory.h"
 
 #include "nld_solver.h"
@@ -65,6 +65,92 @@ namespace netlist
 
 
 
+// ----------------------------------------------------------------------------------------
+// solver_thread_pool_t
+// ----------------------------------------------------------------------------------------
+
+/* Persistent worker threads used if PARALLEL is set. Task 0 is run on the
+ * netlist thread, the remaining tasks each have their own worker.
+ *
+ * The solver update is called at the solver frequency (48kHz and more),
+ * so workers spin for a while before blocking on the condition variable.
+ * A futex round trip for every update would eat up most of the gain.
+ */
+
+class solver_thread_pool_t : plib::nocopyassignmove
+{
+public:
+	solver_thread_pool_t(NETLIB_NAME(solver) &solver, std::size_t num_tasks)
+	: m_solver(solver)
+	, m_generation(0)
+	, m_pending(0)
+	, m_stop(false)
+	{
+		for (std::size_t i = 1; i < num_tasks; i++)
+			m_threads.emplace_back(&solver_thread_pool_t::worker, this, i);
+	}
+
+	~solver_thread_pool_t()
+	{
+		m_stop = true;
+		kick();
+		for (auto &t : m_threads)
+			t.join();
+	}
+
+	void run()
+	{
+		m_pending.store(static_cast<unsigned>(m_threads.size()), std::memory_order_relaxed);
+		kick();
+		m_solver.solve_task(0);
+		for (unsigned spins = 0; m_pending.load(std::memory_order_acquire) != 0; spins++)
+			if (spins >= SPIN_LOOPS)
+				std::this_thread::yield();
+	}
+
+private:
+	static constexpr unsigned SPIN_LOOPS = 20000;
+
+	void kick()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_generation.fetch_add(1, std::memory_order_release);
+		}
+		m_cv.notify_all();
+	}
+
+	void worker(std::size_t idx)
+	{
+		unsigned seen = 0;
+		while (true)
+		{
+			unsigned gen;
+			for (unsigned spins = 0; (gen = m_generation.load(std::memory_order_acquire)) == seen; spins++)
+			{
+				if (spins >= SPIN_LOOPS)
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_cv.wait(lock, [this, seen]() { return m_generation.load(std::memory_order_acquire) != seen; });
+				}
+			}
+			seen = gen;
+			if (m_stop)
+				return;
+			m_solver.solve_task(idx);
+			m_pending.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	NETLIB_NAME(solver) &m_solver;
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::atomic<unsigned> m_generation;
+	std::atomic<unsigned> m_pending;
+	std::atomic<bool> m_stop;
+};
+
 // ----------------------------------------------------------------------------------------
 // solver
 // ----------------------------------------------------------------------------------------
@@ -77,6 +163,7 @@ NETLIB_RESET(solver)
 
 void NETLIB_NAME(solver)::stop()
 {
+	m_pool = nullptr;
 	for (std::size_t i = 0; i < m_mat_solvers.size(); i++)
 		m_mat_solvers[i]->log_stats();
 }
@@ -85,6 +172,16 @@ NETLIB_NAME(solver)::~NETLIB_NAME(solver)()
 {
 }
 
+void NETLIB_NAME(solver)::solve_task(std::size_t idx)
+{
+	for (auto & solver : m_tasks[idx])
+		if (solver->has_timestep_devices() || m_force_solve)
+		{
+			// Ignore return value
+			ATTR_UNUSED const netlist_time ts = solver->solve();
+		}
+}
+
 NETLIB_UPDATE(solver)
 {
 	if (m_params.m_dynamic_ts)
@@ -92,46 +189,29 @@ NETLIB_UPDATE(solver)
 
 	/* force solving during start up if there are no time-step devices */
 	/* FIXME: Needs a more elegant solution */
-	bool force_solve = (netlist().time() < netlist_time::from_double(2 * m_params.m_max_timestep));
+	m_force_solve = (netlist().time() < netlist_time::from_double(2 * m_params.m_max_timestep));
 
-#if HAS_OPENMP && USE_OPENMP
-	const std::size_t t_cnt = m_mat_solvers.size();
-	if (m_parallel())
+	if (m_pool)
 	{
-		//omp_set_num_threads(3);
-		//omp_set_dynamic(0);
-		#pragma omp parallel
-		{
-			#pragma omp for
-			for (int i = 0; i <  t_cnt; i++)
-				if (m_mat_solvers[i]->has_timestep_devices() || force_solve)
-				{
-					// Ignore return value
-					ATTR_UNUSED const netlist_time ts = m_mat_solvers[i]->solve();
-				}
-		}
-
+		/* Net groups don't share nets, so they can be solved concurrently.
+		 * Pushing results to the queue is done afterwards in solver order.
+		 * This keeps results independent of thread count and scheduling.
+		 */
+		m_pool->run();
 		for (auto & solver : m_mat_solvers)
-			if (solver->has_timestep_devices() || force_solve)
+			if (solver->has_timestep_devices() || m_force_solve)
 				solver->update_inputs();
 	}
 	else
-		for (int i = 0; i < t_cnt; i++)
-			if (m_mat_solvers[i]->has_timestep_devices() || force_solve)
+	{
+		for (auto & solver : m_mat_solvers)
+			if (solver->has_timestep_devices() || m_force_solve)
 			{
 				// Ignore return value
-				ATTR_UNUSED const netlist_time ts = m_mat_solvers[i]->solve();
+				ATTR_UNUSED const netlist_time ts = solver->solve();
 				solver->update_inputs();
 			}
-#else
-	for (auto & solver : m_mat_solvers)
-		if (solver->has_timestep_devices() || force_solve)
-		{
-			// Ignore return value
-			ATTR_UNUSED const netlist_time ts = solver->solve();
-			solver->update_inputs();
-		}
-#endif
+	}
 
 	/* step circuit */
 	if (!m_Q_step.net().is_queued())
@@ -140,6 +220,45 @@ NETLIB_UPDATE(solver)
 	}
 }
 
+void NETLIB_NAME(solver)::setup_parallel(std::size_t threads)
+{
+	/* Distribute solvers over tasks by net count, largest first. Solvers
+	 * without time step devices are only solved during start up and
+	 * don't count. The assignment only depends on the netlist.
+	 */
+	std::vector<std::size_t> order(m_mat_solvers.size());
+	std::vector<std::size_t> weight(m_mat_solvers.size());
+	std::size_t active = 0;
+	for (std::size_t i = 0; i < m_mat_solvers.size(); i++)
+	{
+		order[i] = i;
+		weight[i] = m_mat_solvers[i]->has_timestep_devices() ? m_mat_solvers[i]->net_count() : 0;
+		if (weight[i] > 0)
+			active++;
+	}
+	threads = std::min(threads, active);
+	if (threads < 2)
+		return;
+
+	std::stable_sort(order.begin(), order.end(),
+		[&weight](std::size_t a, std::size_t b) { return weight[a] > weight[b]; });
+
+	std::vector<std::size_t> load(threads, 0);
+	m_tasks.resize(threads);
+	for (auto i : order)
+	{
+		auto t = static_cast<std::size_t>(std::min_element(load.begin(), load.end()) - load.begin());
+		load[t] += weight[i];
+		m_tasks[t].push_back(m_mat_solvers[i].get());
+	}
+
+	log().verbose("Solving {1} net groups on {2} threads", m_mat_solvers.size(), threads);
+	for (std::size_t t = 0; t < threads; t++)
+		log().verbose("       thread {1}: {2} solvers, {3} nets", t, m_tasks[t].size(), load[t]);
+
+	m_pool = plib::make_unique<solver_thread_pool_t>(*this, threads);
+}
+
 template <class C>
 std::unique_ptr<matrix_solver_t> create_it(netlist_t &nl, pstring name, solver_parameters_t &params, std::size_t size)
 {
@@ -420,6 +539,15 @@ void NETLIB_NAME(solver)::post_start()
 
 		m_mat_solvers.push_back(std::move(ms));
 	}
+
+	// Override parallel solving
+	pstring pp = plib::util::environment("NL_PARALLEL", "");
+	const long parallel = (pp != "") ? pp.as_long() : m_parallel();
+	if (parallel > 0 && m_params.m_dynamic_ts)
+		log().warning(MW_0_PARALLEL_DYNAMIC_TS);
+	else if (parallel > 0)
+		setup_parallel(std::min(static_cast<std::size_t>(parallel),
+			static_cast<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u))));
 }
 
 void NETLIB_NAME(solver)::create_solver_code(std::map<pstring, pstring> &mp)
@@ -29,6 +29,7 @@ class NETLIB_NAME(solver);
 
 
 class matrix_solver_t;
+class solver_thread_pool_t;
 
 NETLIB_OBJECT(solver)
 {
@@ -48,7 +49,7 @@ NETLIB_OBJECT(solver)
 	, m_pivot(*this, "PIVOT", 0)                    // use pivoting - on supported solvers
 	, m_nr_loops(*this, "NR_LOOPS", 250)            // Newton-Raphson loops
 	, m_nr_recalc_delay(*this, "NR_RECALC_DELAY", NLTIME_FROM_NS(10).as_double()) // Delay to next solve attempt if nr loops exceeded
-	, m_parallel(*this, "PARALLEL", 0)
+	, m_parallel(*this, "PARALLEL", 0)             // threads used to solve net groups, 0 = serial
 
 	/* automatic time step */
 	, m_dynamic_ts(*this, "DYNAMIC_TS", 0)
@@ -57,6 +58,7 @@ NETLIB_OBJECT(solver)
 
 	, m_log_stats(*this, "LOG_STATS", 1)   // nl_double timestep resolution
 	, m_params()
+	, m_force_solve(false)
 	{
 		// internal staff
 
@@ -99,8 +101,18 @@ protected:
 	std::vector<std::unique_ptr<matrix_solver_t>> m_mat_solvers;
 private:
 
+	friend class solver_thread_pool_t;
+
 	solver_parameters_t m_params;
 
+	/* parallel solving of independent net groups */
+	std::unique_ptr<solver_thread_pool_t> m_pool;
+	std::vector<std::vector<matrix_solver_t *>> m_tasks;
+	bool m_force_solve;
+
+	void setup_parallel(std::size_t threads);
+	void solve_task(std::size_t idx);
+
 	template <std::size_t m_N, std::size_t storage_N>
 	std::unique_ptr<matrix_solver_t> create_solver(std::size_t size, const pstring &solvername);
 };
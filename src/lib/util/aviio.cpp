@@ -8,12 +8,22 @@
 
 ***************************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 #include "aviio.h"
+#include "huffman.h"
+
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define AVI_HUFFYUV_SSE2        1
+#else
+#define AVI_HUFFYUV_SSE2        0
+#endif
 
 
 /***************************************************************************
@@ -231,6 +241,30 @@
 
 #define HUFFYUV_PREDICT_DECORR   0x40
 
+/**
+ * @def HUFFYUV_SLICE_ROWS
+ *
+ * @brief   Rows of video encoded by each HuffYUV work item.
+ */
+
+#define HUFFYUV_SLICE_ROWS       32
+
+/**
+ * @def HUFFYUV_LUMA_DECAY
+ *
+ * @brief   Falloff of the residual distribution the HuffYUV luma codes are built for.
+ */
+
+#define HUFFYUV_LUMA_DECAY       0.75
+
+/**
+ * @def HUFFYUV_CHROMA_DECAY
+ *
+ * @brief   Falloff of the residual distribution the HuffYUV chroma codes are built for.
+ */
+
+#define HUFFYUV_CHROMA_DECAY     0.6
+
 
 namespace {
 /***************************************************************************
@@ -265,6 +299,46 @@ struct avi_chunk_list
 	std::uint32_t       length;                 /* length of the chunk including header */
 };
 
+class avi_stream;
+
+/**
+ * @struct  huffyuv_slice
+ *
+ * @brief   A run of rows of a HuffYUV frame, encoded to its own bitstream.
+ */
+
+struct huffyuv_slice
+{
+	avi_stream const *  stream;                 /* stream doing the encoding */
+	bitmap_yuy16 const *bitmap;                 /* source bitmap */
+	int                 starty;                 /* first row */
+	int                 endy;                   /* row after the last */
+	std::vector<std::uint16_t> residuals;       /* left prediction residuals for one row */
+	std::vector<std::uint32_t> words;           /* complete 32-bit words of the bitstream */
+	std::uint32_t       tail;                   /* bits following the last complete word */
+	int                 tailbits;               /* number of bits in the tail */
+};
+
+/**
+ * @class   huffyuv_code_builder
+ *
+ * @brief   Builds HuffYUV code lengths for an assumed residual distribution.
+ */
+
+class huffyuv_code_builder : public huffman_encoder<256, 16>
+{
+public:
+	// weight residuals by a two-sided geometric distribution around zero
+	void set_decay(double ratio)
+	{
+		double weight = 65536.0;
+		for (int delta = 0; delta <= 128; delta++, weight *= ratio)
+			m_datahisto[delta & 0xff] = m_datahisto[-delta & 0xff] = 1 + std::uint32_t(weight);
+	}
+
+	std::uint8_t length(int value) const { return m_huffnode[value].m_numbits; }
+};
+
 /**
  * @struct  avi_stream
  *
@@ -286,6 +360,7 @@ public:
 		, m_depth(0)
 		, m_interlace(0)
 		, m_huffyuv()
+		, m_huffyuv_encoder()
 		, m_channels(0)
 		, m_samplebits(0)
 		, m_samplerate(0)
@@ -365,6 +440,9 @@ public:
 
 	// HuffYUV helpers
 	avi_file::error huffyuv_decompress_to_yuy16(const std::uint8_t *data, std::uint32_t numbytes, bitmap_yuy16 &bitmap) const;
+	avi_file::error huffyuv_build_encoder();
+	std::vector<std::uint8_t> const &huffyuv_extradata() const { return m_huffyuv_encoder->extradata; }
+	void huffyuv_compress_slice(huffyuv_slice &slice) const;
 
 private:
 	struct huffyuv_table
@@ -382,6 +460,18 @@ private:
 		huffyuv_table       table[3];               /* array of tables */
 	};
 
+	struct huffyuv_code_table
+	{
+		std::uint8_t        length[256];            /* code lengths */
+		std::uint32_t       code[256];              /* codes, right-aligned */
+	};
+
+	struct huffyuv_encoder
+	{
+		huffyuv_code_table  table[3];               /* Y, Cb and Cr code tables */
+		std::vector<std::uint8_t> extradata;        /* data following the BITMAPINFOHEADER */
+	};
+
 	avi_file::error huffyuv_extract_tables(const std::uint8_t *chunkdata, std::uint32_t size);
 
 	std::uint32_t       m_type;                 /* subtype of stream */
@@ -398,6 +488,7 @@ private:
 	std::uint32_t       m_depth;                /* depth of video */
 	std::uint8_t        m_interlace;            /* interlace parameters */
 	std::unique_ptr<huffyuv_data const> m_huffyuv; /* huffyuv decompression data */
+	std::unique_ptr<huffyuv_encoder const> m_huffyuv_encoder; /* huffyuv compression data */
 
 	std::uint16_t       m_channels;             /* audio channels */
 	std::uint16_t       m_samplebits;           /* audio bits per sample */
@@ -487,6 +578,8 @@ private:
 		, m_soundbuf_samples(0)
 		, m_soundbuf_chunks(0)
 		, m_soundbuf_frames(0)
+		, m_work_queue(nullptr)
+		, m_slices()
 	{
 		std::fill(std::begin(m_soundbuf_chansamples), std::end(m_soundbuf_chansamples), 0);
 	}
@@ -497,6 +590,7 @@ private:
 	std::uint32_t get_chunkid_for_stream(const avi_stream *stream) const;
 	std::uint32_t framenum_to_samplenum(std::uint32_t framenum) const;
 	error expand_tempbuffer(std::uint32_t length);
+	error huffyuv_compress_frame(avi_stream const &stream, bitmap_yuy16 const &bitmap, std::uint32_t &length);
 
 	// core chunk read routines
 	error get_first_chunk(avi_chunk const *parent, avi_chunk &newchunk);
@@ -561,6 +655,9 @@ private:
 	std::uint32_t       m_soundbuf_chansamples[MAX_SOUND_CHANNELS]; /* samples in buffer for each channel */
 	std::uint32_t       m_soundbuf_chunks;      /* number of chunks completed so far */
 	std::uint32_t       m_soundbuf_frames;      /* number of frames ahead of the video */
+
+	osd_work_queue *    m_work_queue;           /* queue for encoding HuffYUV slices */
+	std::vector<huffyuv_slice> m_slices;        /* HuffYUV slices of the current frame */
 };
 
 
@@ -939,6 +1036,67 @@ inline std::uint32_t avi_file_impl::framenum_to_samplenum(std::uint32_t framenum
 }
 
 
+/*-------------------------------------------------
+    huffyuv_left_residual - compute the left
+    prediction residual of a YUY16 pixel
+-------------------------------------------------*/
+
+/**
+ * @fn  static inline std::uint16_t huffyuv_left_residual(std::uint16_t pixel, std::uint16_t prevy, std::uint16_t prevc)
+ *
+ * @brief   Huffyuv left residual.
+ *
+ * @param   pixel   The pixel.
+ * @param   prevy   The pixel supplying the predicted Y.
+ * @param   prevc   The pixel supplying the predicted Cb/Cr.
+ *
+ * @return  The Y and Cb/Cr residuals packed like a YUY16 pixel.
+ */
+
+inline std::uint16_t huffyuv_left_residual(std::uint16_t pixel, std::uint16_t prevy, std::uint16_t prevc)
+{
+	return (((pixel & 0xff00) - (prevy & 0xff00)) & 0xff00) | ((pixel - prevc) & 0x00ff);
+}
+
+
+/*-------------------------------------------------
+    huffyuv_left_residuals - compute left
+    prediction residuals for the part of a row
+    predicted entirely from the same row
+-------------------------------------------------*/
+
+/**
+ * @fn  static inline void huffyuv_left_residuals(const std::uint16_t *source, std::uint16_t *dest, int width)
+ *
+ * @brief   Huffyuv left residuals.
+ *
+ * @param   source          The source row.
+ * @param [in,out]  dest    The residuals; the first two are left alone.
+ * @param   width           The width.
+ */
+
+inline void huffyuv_left_residuals(const std::uint16_t *source, std::uint16_t *dest, int width)
+{
+	int x = 2;
+
+#if AVI_HUFFYUV_SSE2
+	/* Y is predicted from the previous pixel and Cb/Cr from the one before that */
+	__m128i const ymask = _mm_set1_epi16(std::int16_t(0xff00));
+	for ( ; x + 8 <= width; x += 8)
+	{
+		__m128i const pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x]));
+		__m128i const prevy = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x - 1]));
+		__m128i const prevc = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[x - 2]));
+		__m128i const predicted = _mm_or_si128(_mm_and_si128(prevy, ymask), _mm_andnot_si128(ymask, prevc));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[x]), _mm_sub_epi8(pixels, predicted));
+	}
+#endif
+
+	for ( ; x < width; x++)
+		dest[x] = huffyuv_left_residual(source[x], source[x - 1], source[x - 2]);
+}
+
+
 /*-------------------------------------------------
     expand_tempbuffer - expand the file's
     tempbuffer if necessary to contain the
@@ -1485,6 +1643,165 @@ avi_file::error avi_stream::huffyuv_decompress_to_yuy16(const std::uint8_t *data
 }
 
 
+/*-------------------------------------------------
+    huffyuv_build_encoder - build the HuffYUV
+    code tables used to compress frames
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_file::error avi_stream::huffyuv_build_encoder()
+ *
+ * @brief   Huffyuv build encoder.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_stream::huffyuv_build_encoder()
+{
+	/* allocate memory for the data */
+	std::unique_ptr<huffyuv_encoder> encoder;
+	try { encoder = std::make_unique<huffyuv_encoder>(); }
+	catch (...) { return avi_file::error::NO_MEMORY; }
+
+	/* left predictor, 16bpp YUV data, no interlace flags */
+	encoder->extradata.push_back(HUFFYUV_PREDICT_LEFT);
+	encoder->extradata.push_back(16);
+	encoder->extradata.push_back(0);
+	encoder->extradata.push_back(0);
+
+	/* loop over tables */
+	for (int tabnum = 0; tabnum < 3; tabnum++)
+	{
+		huffyuv_code_table &table = encoder->table[tabnum];
+
+		/* residuals mostly sit close to zero, chroma more so than luma */
+		huffyuv_code_builder builder;
+		builder.set_decay((tabnum == 0) ? HUFFYUV_LUMA_DECAY : HUFFYUV_CHROMA_DECAY);
+		if (builder.compute_tree_from_histo() != HUFFERR_NONE)
+			return avi_file::error::INVALID_DATA;
+		for (int value = 0; value < 256; value++)
+			table.length[value] = builder.length(value);
+
+		/* assign codes in the same order huffyuv_extract_tables does, longest first */
+		std::uint32_t curbits = 0;
+		for (int bits = 31; bits > 0; bits--)
+			for (int value = 0; value < 256; value++)
+				if (table.length[value] == bits)
+				{
+					table.code[value] = curbits >> (32 - bits);
+					curbits += std::uint32_t(1) << (32 - bits);
+				}
+
+		/* store the lengths as runs, in the format huffyuv_extract_tables reads */
+		for (int value = 0; value < 256; )
+		{
+			int count = 1;
+			while (value + count < 256 && count < 255 && table.length[value + count] == table.length[value])
+				count++;
+			if (count < 8)
+				encoder->extradata.push_back((count << 5) | table.length[value]);
+			else
+			{
+				encoder->extradata.push_back(table.length[value]);
+				encoder->extradata.push_back(count);
+			}
+			value += count;
+		}
+	}
+
+	m_huffyuv_encoder = std::move(encoder);
+	return avi_file::error::NONE;
+}
+
+
+/*-------------------------------------------------
+    huffyuv_compress_slice - left predict and
+    HuffYUV encode a run of rows from a YUY16
+    bitmap
+-------------------------------------------------*/
+
+/**
+ * @fn  void avi_stream::huffyuv_compress_slice(huffyuv_slice &slice) const
+ *
+ * @brief   Huffyuv compress slice.
+ *
+ * @param [in,out]  slice   The slice, which receives the bitstream.
+ */
+
+void avi_stream::huffyuv_compress_slice(huffyuv_slice &slice) const
+{
+	huffyuv_code_table const &ytable = m_huffyuv_encoder->table[0];
+	std::uint64_t accum = 0;
+	int accumbits = 0;
+
+	slice.residuals.resize(m_width);
+	slice.words.clear();
+	slice.words.reserve((slice.endy - slice.starty) * m_width / 2);
+
+	for (int y = slice.starty; y < slice.endy; y++)
+	{
+		const std::uint16_t *const source = &slice.bitmap->pix16(y);
+		std::uint16_t *const residuals = &slice.residuals[0];
+		int x = 0;
+
+		/* the first DWORD is stored as YUY2; otherwise the first pixels predict from the row above */
+		if (y == 0)
+			x = 2;
+		else
+		{
+			const std::uint16_t *const prevrow = &slice.bitmap->pix16(y - 1);
+			residuals[0] = huffyuv_left_residual(source[0], prevrow[m_width - 1], prevrow[m_width - 2]);
+			residuals[1] = huffyuv_left_residual(source[1], source[0], prevrow[m_width - 1]);
+		}
+		huffyuv_left_residuals(source, residuals, m_width);
+
+		/* encode Y and Cb/Cr together; codes are at most 16 bits so this never overflows */
+		for ( ; x < m_width; x++)
+		{
+			huffyuv_code_table const &ctable = m_huffyuv_encoder->table[1 + (x & 1)];
+			std::uint8_t const yvalue = residuals[x] >> 8;
+			std::uint8_t const cvalue = residuals[x] & 0xff;
+			int const clength = ctable.length[cvalue];
+
+			accum = (accum << (ytable.length[yvalue] + clength)) | (ytable.code[yvalue] << clength) | ctable.code[cvalue];
+			accumbits += ytable.length[yvalue] + clength;
+			if (accumbits >= 32)
+			{
+				accumbits -= 32;
+				slice.words.push_back(std::uint32_t(accum >> accumbits));
+			}
+		}
+	}
+
+	slice.tail = std::uint32_t(accum & ((std::uint64_t(1) << accumbits) - 1));
+	slice.tailbits = accumbits;
+}
+
+
+/*-------------------------------------------------
+    huffyuv_compress_callback - work queue
+    callback to compress a HuffYUV slice
+-------------------------------------------------*/
+
+/**
+ * @fn  static void *huffyuv_compress_callback(void *param, int threadid)
+ *
+ * @brief   Huffyuv compress callback.
+ *
+ * @param [in,out]  param   The slice.
+ * @param   threadid        The thread ID.
+ *
+ * @return  null.
+ */
+
+void *huffyuv_compress_callback(void *param, int threadid)
+{
+	huffyuv_slice &slice = *reinterpret_cast<huffyuv_slice *>(param);
+	slice.stream->huffyuv_compress_slice(slice);
+	return nullptr;
+}
+
+
 /*-------------------------------------------------
     avi_close - close an AVI movie file
 -------------------------------------------------*/
@@ -1538,6 +1855,9 @@ avi_file_impl::~avi_file_impl()
 	/* close the file */
 	m_file.reset();
 
+	if (m_work_queue)
+		osd_work_queue_free(m_work_queue);
+
 	//return avierr;
 }
 
@@ -1817,16 +2137,28 @@ avi_file::error avi_file_impl::append_video_frame(bitmap_yuy16 &bitmap)
 	if (avierr != error::NONE)
 		return avierr;
 
-	/* make sure we have enough room */
-	maxlength = 2 * stream->width() * stream->height();
-	avierr = expand_tempbuffer(maxlength);
-	if (avierr != error::NONE)
-		return avierr;
+	/* HuffYUV-compressed */
+	if (stream->format() == FORMAT_HFYU)
+	{
+		avierr = huffyuv_compress_frame(*stream, bitmap, maxlength);
+		if (avierr != error::NONE)
+			return avierr;
+	}
 
-	/* now compress the data */
-	avierr = stream->yuy16_compress_to_yuy(bitmap, &m_tempbuffer[0], maxlength);
-	if (avierr != error::NONE)
-		return avierr;
+	/* other YUV-compressed */
+	else
+	{
+		/* make sure we have enough room */
+		maxlength = 2 * stream->width() * stream->height();
+		avierr = expand_tempbuffer(maxlength);
+		if (avierr != error::NONE)
+			return avierr;
+
+		/* now compress the data */
+		avierr = stream->yuy16_compress_to_yuy(bitmap, &m_tempbuffer[0], maxlength);
+		if (avierr != error::NONE)
+			return avierr;
+	}
 
 	/* write the data */
 	avierr = chunk_write(get_chunkid_for_stream(stream), &m_tempbuffer[0], maxlength);
@@ -1844,6 +2176,108 @@ avi_file::error avi_file_impl::append_video_frame(bitmap_yuy16 &bitmap)
 }
 
 
+/*-------------------------------------------------
+    huffyuv_compress_frame - HuffYUV encode a
+    frame into the tempbuffer, splitting the rows
+    across the work queue
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_file::error avi_file_impl::huffyuv_compress_frame(avi_stream const &stream, bitmap_yuy16 const &bitmap, std::uint32_t &length)
+ *
+ * @brief   Huffyuv compress frame.
+ *
+ * @param   stream          The stream.
+ * @param   bitmap          The bitmap.
+ * @param [out]  length     The length of the compressed frame.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_file_impl::huffyuv_compress_frame(avi_stream const &stream, bitmap_yuy16 const &bitmap, std::uint32_t &length)
+{
+	int const width = stream.width();
+	int const height = stream.height();
+
+	/* the encoder reads whole rows */
+	if (bitmap.width() < width || bitmap.height() < height)
+		return error::INVALID_BITMAP;
+
+	/* make sure we have enough room; codes are at most 16 bits */
+	error const avierr = expand_tempbuffer(4 + 4 * width * height);
+	if (avierr != error::NONE)
+		return avierr;
+
+	/* split the frame into slices */
+	int const slices = (height + HUFFYUV_SLICE_ROWS - 1) / HUFFYUV_SLICE_ROWS;
+	if (m_slices.size() < slices)
+	{
+		try { m_slices.resize(slices); }
+		catch (...) { return error::NO_MEMORY; }
+	}
+	for (int slicenum = 0; slicenum < slices; slicenum++)
+	{
+		huffyuv_slice &slice = m_slices[slicenum];
+		slice.stream = &stream;
+		slice.bitmap = &bitmap;
+		slice.starty = slicenum * HUFFYUV_SLICE_ROWS;
+		slice.endy = (std::min)(slice.starty + HUFFYUV_SLICE_ROWS, height);
+	}
+
+	/* encode them in parallel if we can */
+	if (slices > 1 && !m_work_queue)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (slices > 1 && m_work_queue)
+	{
+		osd_work_item_queue_multiple(m_work_queue, huffyuv_compress_callback, slices, &m_slices[0], sizeof(m_slices[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(m_work_queue, osd_ticks_per_second())) { }
+	}
+	else
+	{
+		for (int slicenum = 0; slicenum < slices; slicenum++)
+			stream.huffyuv_compress_slice(m_slices[slicenum]);
+	}
+
+	/* first DWORD is stored as YUY2 */
+	std::uint8_t *dest = &m_tempbuffer[0];
+	const std::uint16_t *const source = &bitmap.pix16(0);
+	*dest++ = source[0] >> 8;
+	*dest++ = source[0];
+	*dest++ = source[1] >> 8;
+	*dest++ = source[1];
+
+	/* then join the slices into one bitstream of little-endian DWORDs */
+	std::uint64_t accum = 0;
+	int accumbits = 0;
+	for (int slicenum = 0; slicenum < slices; slicenum++)
+	{
+		huffyuv_slice const &slice = m_slices[slicenum];
+		for (std::uint32_t word : slice.words)
+		{
+			accum = (accum << 32) | word;
+			put_32bits(dest, std::uint32_t(accum >> accumbits));
+			dest += 4;
+		}
+		accum = (accum << slice.tailbits) | slice.tail;
+		accumbits += slice.tailbits;
+		if (accumbits >= 32)
+		{
+			accumbits -= 32;
+			put_32bits(dest, std::uint32_t(accum >> accumbits));
+			dest += 4;
+		}
+	}
+	if (accumbits > 0)
+	{
+		put_32bits(dest, std::uint32_t(accum << (32 - accumbits)));
+		dest += 4;
+	}
+
+	length = dest - &m_tempbuffer[0];
+	return error::NONE;
+}
+
+
 /*-------------------------------------------------
     avi_append_video_frame_rgb32 - append a frame
     of video in RGB32 format
@@ -2916,6 +3350,14 @@ avi_file::error avi_file_impl::write_initial_headers()
 		if (avierr != error::NONE)
 			return avierr;
 
+		/* HuffYUV streams need their code tables for the strf chunk */
+		if (m_streams[strnum].format() == FORMAT_HFYU)
+		{
+			avierr = m_streams[strnum].huffyuv_build_encoder();
+			if (avierr != error::NONE)
+				return avierr;
+		}
+
 		/* write the strf chunk */
 		avierr = write_strf_chunk(m_streams[strnum]);
 		if (avierr != error::NONE)
@@ -3059,12 +3501,13 @@ avi_file::error avi_file_impl::write_strf_chunk(avi_stream const &stream)
 	/* video stream */
 	if (stream.type() == STREAMTYPE_VIDS)
 	{
-		std::uint8_t buffer[40];
-
-		/* reset the buffer */
-		std::memset(buffer, 0, sizeof(buffer));
+		/* HuffYUV code tables follow the header */
+		std::uint32_t const extrasize = (stream.format() == FORMAT_HFYU) ? stream.huffyuv_extradata().size() : 0;
+		std::vector<std::uint8_t> buffer(40 + extrasize, 0);
+		if (extrasize > 0)
+			std::copy(stream.huffyuv_extradata().begin(), stream.huffyuv_extradata().end(), buffer.begin() + 40);
 
-		put_32bits(&buffer[0], sizeof(buffer));         /* biSize */
+		put_32bits(&buffer[0], buffer.size());          /* biSize */
 		put_32bits(&buffer[4], stream.width());         /* biWidth */
 		put_32bits(&buffer[8], stream.height());        /* biHeight */
 		put_16bits(&buffer[12], 1);                     /* biPlanes */
@@ -3074,7 +3517,7 @@ avi_file::error avi_file_impl::write_strf_chunk(avi_stream const &stream)
 					stream.width() * stream.height() * (stream.depth() + 7) / 8);
 
 		/* write the chunk */
-		return chunk_write(CHUNKTYPE_STRF, buffer, sizeof(buffer));
+		return chunk_write(CHUNKTYPE_STRF, &buffer[0], buffer.size());
 	}
 
 	/* audio stream */
@@ -3594,7 +4037,8 @@ avi_file::error avi_file::open(std::string const &filename, ptr &file)
 avi_file::error avi_file::create(std::string const &filename, movie_info const &info, ptr &file)
 {
 	/* validate video info */
-	if ((info.video_format != 0 && info.video_format != FORMAT_UYVY && info.video_format != FORMAT_VYUY && info.video_format != FORMAT_YUY2) ||
+	if ((info.video_format != 0 && info.video_format != FORMAT_UYVY && info.video_format != FORMAT_VYUY && info.video_format != FORMAT_YUY2 && info.video_format != FORMAT_HFYU) ||
+		(info.video_format == FORMAT_HFYU && (info.video_depth != 16 || (info.video_width & 1) != 0)) ||
 		(info.video_width == 0) ||
 		(info.video_height == 0) ||
 		(info.video_depth == 0) ||
@@ -15,7 +15,38 @@
 #include <zlib.h>
 #include "png.h"
 
+#include <algorithm>
+#include <mutex>
 #include <new>
+#include <thread>
+#include <vector>
+
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define PNG_FILTER_SSE2     1
+#else
+#define PNG_FILTER_SSE2     0
+#endif
+
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* images at least this big are filtered and deflated on a work queue */
+static const uint32_t PARALLEL_THRESHOLD = 512 * 1024;
+
+/* rows filtered per work item */
+static const int FILTER_ROWS = 64;
+
+/* uncompressed bytes per independently deflated block, and the amount of
+   the preceding data each block uses as its dictionary */
+static const uint32_t DEFLATE_BLOCK_SIZE = 128 * 1024;
+static const uint32_t DEFLATE_DICT_SIZE = 32 * 1024;
+
+/* pixels examined when deciding whether an image has few colours */
+static const uint32_t COLOUR_SCAN_PIXELS = 16 * 1024;
 
 
 /***************************************************************************
@@ -30,6 +61,28 @@ struct image_data_chunk
 };
 
 
+struct filter_work
+{
+	png_info *          pnginfo;
+	const uint8_t *     source;     /* unfiltered image */
+	int                 firstrow;
+	int                 numrows;
+};
+
+
+struct deflate_work
+{
+	const uint8_t *     data;
+	uint32_t            length;
+	uint32_t            dictlength; /* bytes immediately before data to prime the dictionary */
+	bool                last;
+	int                 strategy;
+	std::vector<uint8_t> output;
+	uint32_t            adler;
+	int                 zerr;
+};
+
+
 struct png_private
 {
 	png_info *          pnginfo;
@@ -778,13 +831,429 @@ static png_error write_chunk(util::core_file &fp, const uint8_t *data, uint32_t
 }
 
 
+/*-------------------------------------------------
+    paeth_predictor - the PNG Paeth predictor
+-------------------------------------------------*/
+
+static inline uint8_t paeth_predictor(uint8_t a, uint8_t b, uint8_t c)
+{
+	int pa = abs(b - c);
+	int pb = abs(a - c);
+	int pc = abs(a + b - 2 * c);
+	if (pa <= pb && pa <= pc)
+		return a;
+	return (pb <= pc) ? b : c;
+}
+
+
+#if PNG_FILTER_SSE2
+/*-------------------------------------------------
+    filter_16 - compute the Sub, Up and Paeth
+    filtered forms of 16 bytes; raw is the data,
+    a the bytes to the left, b the bytes above
+    and c the bytes above and to the left
+-------------------------------------------------*/
+
+static inline void filter_16(__m128i raw, __m128i a, __m128i b, __m128i c, __m128i &sub, __m128i &up, __m128i &paeth)
+{
+	__m128i const zero = _mm_setzero_si128();
+	sub = _mm_sub_epi8(raw, a);
+	up = _mm_sub_epi8(raw, b);
+
+	/* the predictor works in 16 bits, eight bytes at a time */
+	__m128i pred[2];
+	for (int half = 0; half < 2; half++)
+	{
+		__m128i const a16 = half ? _mm_unpackhi_epi8(a, zero) : _mm_unpacklo_epi8(a, zero);
+		__m128i const b16 = half ? _mm_unpackhi_epi8(b, zero) : _mm_unpacklo_epi8(b, zero);
+		__m128i const c16 = half ? _mm_unpackhi_epi8(c, zero) : _mm_unpacklo_epi8(c, zero);
+		__m128i const bc = _mm_sub_epi16(b16, c16);
+		__m128i const ac = _mm_sub_epi16(a16, c16);
+		__m128i const abc = _mm_add_epi16(bc, ac);
+		__m128i const pa = _mm_max_epi16(bc, _mm_sub_epi16(zero, bc));
+		__m128i const pb = _mm_max_epi16(ac, _mm_sub_epi16(zero, ac));
+		__m128i const pc = _mm_max_epi16(abc, _mm_sub_epi16(zero, abc));
+		__m128i const not_a = _mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc));
+		__m128i const not_b = _mm_cmpgt_epi16(pb, pc);
+		__m128i const bc_pick = _mm_or_si128(_mm_andnot_si128(not_b, b16), _mm_and_si128(not_b, c16));
+		pred[half] = _mm_or_si128(_mm_andnot_si128(not_a, a16), _mm_and_si128(not_a, bc_pick));
+	}
+	paeth = _mm_sub_epi8(raw, _mm_packus_epi16(pred[0], pred[1]));
+}
+
+
+/*-------------------------------------------------
+    score_16 - add the sum of the magnitudes of
+    16 filtered bytes, read as signed, to a
+    running total
+-------------------------------------------------*/
+
+static inline __m128i score_16(__m128i total, __m128i filtered)
+{
+	__m128i const magnitude = _mm_min_epu8(filtered, _mm_sub_epi8(_mm_setzero_si128(), filtered));
+	return _mm_add_epi64(total, _mm_sad_epu8(magnitude, _mm_setzero_si128()));
+}
+
+
+static inline uint32_t score_total(__m128i total)
+{
+	return _mm_cvtsi128_si32(total) + _mm_cvtsi128_si32(_mm_srli_si128(total, 8));
+}
+#endif
+
+
+/*-------------------------------------------------
+    filter_row - choose a filter for a row and
+    write the filtered row; the choice goes to
+    whichever of None, Sub, Up and Paeth gives
+    the smallest sum of magnitudes, which is the
+    usual heuristic
+-------------------------------------------------*/
+
+static void filter_row(uint8_t *dst, const uint8_t *src, const uint8_t *prior, int bpp, int rowbytes)
+{
+	uint32_t score[5] = { 0, 0, 0, 0, 0 };
+	int x = 0;
+
+	/* the first pixel has nothing to the left */
+	auto const left = [&] (int index) -> uint8_t { return (index >= bpp) ? src[index - bpp] : 0; };
+	auto const above = [&] (int index) -> uint8_t { return prior ? prior[index] : 0; };
+	auto const aboveleft = [&] (int index) -> uint8_t { return (prior && index >= bpp) ? prior[index - bpp] : 0; };
+	auto const magnitude = [] (uint8_t value) -> uint32_t { return (value < 128) ? value : (256 - value); };
+
+#if PNG_FILTER_SSE2
+	__m128i total[5] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+	for ( ; x < bpp && x < rowbytes; x++)
+	{
+		score[PNG_PF_None] += magnitude(src[x]);
+		score[PNG_PF_Sub] += magnitude(src[x]);
+		score[PNG_PF_Up] += magnitude(src[x] - above(x));
+		score[PNG_PF_Paeth] += magnitude(src[x] - above(x));
+	}
+	__m128i const zero = _mm_setzero_si128();
+	for ( ; x + 16 <= rowbytes; x += 16)
+	{
+		__m128i const raw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+		__m128i const a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x - bpp));
+		__m128i const b = prior ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(prior + x)) : zero;
+		__m128i const c = prior ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(prior + x - bpp)) : zero;
+		__m128i sub, up, paeth;
+		filter_16(raw, a, b, c, sub, up, paeth);
+		total[PNG_PF_None] = score_16(total[PNG_PF_None], raw);
+		total[PNG_PF_Sub] = score_16(total[PNG_PF_Sub], sub);
+		total[PNG_PF_Up] = score_16(total[PNG_PF_Up], up);
+		total[PNG_PF_Paeth] = score_16(total[PNG_PF_Paeth], paeth);
+	}
+	for (int type : { PNG_PF_None, PNG_PF_Sub, PNG_PF_Up, PNG_PF_Paeth })
+		score[type] += score_total(total[type]);
+#endif
+
+	/* score whatever is left one byte at a time */
+	for ( ; x < rowbytes; x++)
+	{
+		score[PNG_PF_None] += magnitude(src[x]);
+		score[PNG_PF_Sub] += magnitude(src[x] - left(x));
+		score[PNG_PF_Up] += magnitude(src[x] - above(x));
+		score[PNG_PF_Paeth] += magnitude(src[x] - paeth_predictor(left(x), above(x), aboveleft(x)));
+	}
+
+	/* pick the best, preferring the simpler filters on a tie */
+	int best = PNG_PF_None;
+	for (int type : { PNG_PF_Sub, PNG_PF_Up, PNG_PF_Paeth })
+		if (score[type] < score[best])
+			best = type;
+
+	/* store the filter byte, then the filtered data */
+	*dst++ = best;
+	switch (best)
+	{
+		case PNG_PF_None:
+			memcpy(dst, src, rowbytes);
+			break;
+
+		case PNG_PF_Sub:
+			for (x = 0; x < rowbytes; x++)
+				dst[x] = src[x] - left(x);
+			break;
+
+		case PNG_PF_Up:
+			for (x = 0; x < rowbytes; x++)
+				dst[x] = src[x] - above(x);
+			break;
+
+		case PNG_PF_Paeth:
+			x = 0;
+#if PNG_FILTER_SSE2
+			for ( ; x < bpp && x < rowbytes; x++)
+				dst[x] = src[x] - above(x);
+			for ( ; x + 16 <= rowbytes; x += 16)
+			{
+				__m128i const raw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+				__m128i const a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x - bpp));
+				__m128i const b = prior ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(prior + x)) : zero;
+				__m128i const c = prior ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(prior + x - bpp)) : zero;
+				__m128i sub, up, paeth;
+				filter_16(raw, a, b, c, sub, up, paeth);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), paeth);
+			}
+#endif
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] - paeth_predictor(left(x), above(x), aboveleft(x));
+			break;
+	}
+}
+
+
+/*-------------------------------------------------
+    filter_rows - work item callback to filter a
+    group of rows
+-------------------------------------------------*/
+
+static void *filter_rows(void *param, int threadid)
+{
+	filter_work &work = *reinterpret_cast<filter_work *>(param);
+	int const bpp = compute_bpp(work.pnginfo);
+	int const rowbytes = compute_rowbytes(work.pnginfo);
+
+	for (int y = work.firstrow; y < work.firstrow + work.numrows; y++)
+	{
+		const uint8_t *src = work.source + y * (rowbytes + 1) + 1;
+		const uint8_t *prior = (y == 0) ? nullptr : (src - (rowbytes + 1));
+		filter_row(work.pnginfo->image + y * (rowbytes + 1), src, prior, bpp, rowbytes);
+	}
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    has_few_colours - return true if an RGB or
+    RGBA image appears to use no more than 256
+    colours; only a spread of rows is examined,
+    since this just picks a compression strategy
+-------------------------------------------------*/
+
+static bool has_few_colours(const png_info *pnginfo)
+{
+	int const bpp = compute_bpp(pnginfo);
+	int const rowbytes = compute_rowbytes(pnginfo);
+	int const rowstep = std::max<int>(1, (uint64_t(pnginfo->width) * pnginfo->height + COLOUR_SCAN_PIXELS - 1) / COLOUR_SCAN_PIXELS);
+
+	/* a small open hash of the colours seen so far; zero marks an empty slot,
+	   so colours are stored with bit 32 set */
+	uint64_t table[1024] = { 0 };
+	int colours = 0;
+	uint64_t last = 0;
+	for (int y = rowstep / 2; y < pnginfo->height; y += rowstep)
+	{
+		const uint8_t *src = pnginfo->image + y * (rowbytes + 1) + 1;
+		for (int x = 0; x < rowbytes; x += bpp)
+		{
+			uint64_t colour = (uint64_t(1) << 32) | (src[x] << 16) | (src[x + 1] << 8) | src[x + 2];
+			if (bpp == 4)
+				colour |= uint32_t(src[x + 3]) << 24;
+			if (colour == last)
+				continue;
+			last = colour;
+
+			uint32_t slot = (uint32_t(colour) * 0x9e3779b1U) >> 22;
+			while (table[slot] != 0 && table[slot] != colour)
+				slot = (slot + 1) & 1023;
+			if (table[slot] == 0)
+			{
+				if (++colours > 256)
+					return false;
+				table[slot] = colour;
+			}
+		}
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    filter_image - replace the unfiltered image
+    with a filtered one, optionally spreading the
+    work across a work queue
+-------------------------------------------------*/
+
+static png_error filter_image(png_info *pnginfo, osd_work_queue *queue)
+{
+	int const rowbytes = compute_rowbytes(pnginfo);
+
+	/* keep the unfiltered image as the source */
+	uint8_t *const source = pnginfo->image;
+	pnginfo->image = (uint8_t *)malloc(pnginfo->height * (rowbytes + 1));
+	if (pnginfo->image == nullptr)
+	{
+		pnginfo->image = source;
+		return PNGERR_OUT_OF_MEMORY;
+	}
+
+	/* split the rows into groups */
+	std::vector<filter_work> work((pnginfo->height + FILTER_ROWS - 1) / FILTER_ROWS);
+	for (int index = 0; index < work.size(); index++)
+	{
+		work[index].pnginfo = pnginfo;
+		work[index].source = source;
+		work[index].firstrow = index * FILTER_ROWS;
+		work[index].numrows = std::min<int>(FILTER_ROWS, pnginfo->height - index * FILTER_ROWS);
+	}
+
+	if (queue != nullptr && work.size() > 1)
+	{
+		osd_work_item_queue_multiple(queue, filter_rows, work.size(), &work[0], sizeof(work[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+	}
+	else
+		for (filter_work &group : work)
+			filter_rows(&group, 0);
+
+	free(source);
+	return PNGERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    deflate_block - work item callback to deflate
+    one block of a chunk as a raw deflate stream,
+    primed with the data before it
+-------------------------------------------------*/
+
+static void *deflate_block(void *param, int threadid)
+{
+	deflate_work &work = *reinterpret_cast<deflate_work *>(param);
+	z_stream stream;
+
+	work.adler = adler32(adler32(0, nullptr, 0), work.data, work.length);
+
+	memset(&stream, 0, sizeof(stream));
+	work.zerr = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, work.strategy);
+	if (work.zerr != Z_OK)
+		return nullptr;
+	if (work.dictlength != 0)
+	{
+		work.zerr = deflateSetDictionary(&stream, work.data - work.dictlength, work.dictlength);
+		if (work.zerr != Z_OK)
+		{
+			deflateEnd(&stream);
+			return nullptr;
+		}
+	}
+
+	/* all but the last block end on a byte boundary without the final bit set,
+	   so the blocks can simply be concatenated */
+	work.output.resize(deflateBound(&stream, work.length) + 16);
+	stream.next_in = const_cast<uint8_t *>(work.data);
+	stream.avail_in = work.length;
+	stream.next_out = &work.output[0];
+	stream.avail_out = work.output.size();
+	for ( ; ; )
+	{
+		work.zerr = deflate(&stream, work.last ? Z_FINISH : Z_SYNC_FLUSH);
+		if (work.zerr == Z_STREAM_END || (work.zerr == Z_OK && !work.last && stream.avail_in == 0 && stream.avail_out != 0))
+			break;
+		if (work.zerr != Z_OK && work.zerr != Z_BUF_ERROR)
+		{
+			deflateEnd(&stream);
+			return nullptr;
+		}
+
+		/* out of space; grow the buffer and carry on */
+		size_t const used = work.output.size() - stream.avail_out;
+		work.output.resize(work.output.size() * 2);
+		stream.next_out = &work.output[used];
+		stream.avail_out = work.output.size() - used;
+	}
+	work.output.resize(work.output.size() - stream.avail_out);
+
+	/* an unfinished stream always reports a data error when freed */
+	work.zerr = deflateEnd(&stream);
+	if (!work.last && work.zerr == Z_DATA_ERROR)
+		work.zerr = Z_OK;
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    write_parallel_deflated_chunk - write an
+    in-memory chunk to the given file, deflating
+    independent blocks on a work queue and
+    joining them into a single zlib stream
+-------------------------------------------------*/
+
+static png_error write_parallel_deflated_chunk(util::core_file &fp, const uint8_t *data, uint32_t type, uint32_t length, int strategy, osd_work_queue *queue)
+{
+	/* deflate the blocks */
+	std::vector<deflate_work> work((length + DEFLATE_BLOCK_SIZE - 1) / DEFLATE_BLOCK_SIZE);
+	for (uint32_t index = 0; index < work.size(); index++)
+	{
+		uint32_t const offset = index * DEFLATE_BLOCK_SIZE;
+		work[index].data = data + offset;
+		work[index].length = std::min(DEFLATE_BLOCK_SIZE, length - offset);
+		work[index].dictlength = std::min(DEFLATE_DICT_SIZE, offset);
+		work[index].last = (index == work.size() - 1);
+		work[index].strategy = strategy;
+		work[index].zerr = Z_OK;
+	}
+	osd_work_item_queue_multiple(queue, deflate_block, work.size(), &work[0], sizeof(work[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+
+	/* zlib header for the default level, then the blocks, then the Adler-32 of it all */
+	uint8_t header[2] = { 0x78, 0x9c };
+	uint32_t adler = adler32(0, nullptr, 0);
+	uint32_t zlength = sizeof(header) + 4;
+	for (deflate_work &block : work)
+	{
+		if (block.zerr != Z_OK)
+			return PNGERR_COMPRESS_ERROR;
+		adler = adler32_combine(adler, block.adler, block.length);
+		zlength += block.output.size();
+	}
+	uint8_t trailer[4];
+	put_32bit(trailer, adler);
+
+	/* write the chunk header */
+	uint8_t tempbuff[8];
+	put_32bit(tempbuff + 0, zlength);
+	put_32bit(tempbuff + 4, type);
+	uint32_t crc = crc32(0, tempbuff + 4, 4);
+	if (fp.write(tempbuff, 8) != 8)
+		return PNGERR_FILE_ERROR;
+
+	/* write the stream */
+	if (fp.write(header, sizeof(header)) != sizeof(header))
+		return PNGERR_FILE_ERROR;
+	crc = crc32(crc, header, sizeof(header));
+	for (deflate_work &block : work)
+	{
+		if (fp.write(&block.output[0], block.output.size()) != block.output.size())
+			return PNGERR_FILE_ERROR;
+		crc = crc32(crc, &block.output[0], block.output.size());
+	}
+	if (fp.write(trailer, sizeof(trailer)) != sizeof(trailer))
+		return PNGERR_FILE_ERROR;
+	crc = crc32(crc, trailer, sizeof(trailer));
+
+	/* write the CRC */
+	put_32bit(tempbuff, crc);
+	if (fp.write(tempbuff, 4) != 4)
+		return PNGERR_FILE_ERROR;
+
+	return PNGERR_NONE;
+}
+
+
 /*-------------------------------------------------
     write_deflated_chunk - write an in-memory
     chunk to the given file by deflating it
 -------------------------------------------------*/
 
-static png_error write_deflated_chunk(util::core_file &fp, uint8_t *data, uint32_t type, uint32_t length)
+static png_error write_deflated_chunk(util::core_file &fp, uint8_t *data, uint32_t type, uint32_t length, int strategy, osd_work_queue *queue)
 {
+	/* big chunks are split up when we have a queue */
+	if (queue != nullptr && length >= PARALLEL_THRESHOLD)
+		return write_parallel_deflated_chunk(fp, data, type, length, strategy, queue);
+
 	uint64_t lengthpos = fp.tell();
 	uint8_t tempbuff[8192];
 	uint32_t zlength = 0;
@@ -805,7 +1274,7 @@ static png_error write_deflated_chunk(util::core_file &fp, uint8_t *data, uint32
 	memset(&stream, 0, sizeof(stream));
 	stream.next_in = data;
 	stream.avail_in = length;
-	zerr = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
+	zerr = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS, 8, strategy);
 	if (zerr != Z_OK)
 		return PNGERR_COMPRESS_ERROR;
 
@@ -1001,6 +1470,48 @@ static png_error convert_bitmap_to_image_rgb(png_info *pnginfo, const bitmap_t &
 }
 
 
+/*-------------------------------------------------
+    shared_work_queue - one work queue for all big
+    images, created the first time it is needed;
+    acquire returns nullptr if there is only one
+    CPU or another image is using the queue, and
+    the caller then works serially
+-------------------------------------------------*/
+
+namespace {
+
+class shared_work_queue
+{
+public:
+	~shared_work_queue() { if (m_queue != nullptr) osd_work_queue_free(m_queue); }
+
+	osd_work_queue *acquire()
+	{
+		if (std::thread::hardware_concurrency() < 2 || !m_lock.try_lock())
+			return nullptr;
+		if (m_queue == nullptr)
+			m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		if (m_queue == nullptr)
+			m_lock.unlock();
+		return m_queue;
+	}
+
+	void release(osd_work_queue *queue)
+	{
+		if (queue != nullptr)
+			m_lock.unlock();
+	}
+
+private:
+	std::mutex          m_lock;             // held while an image is using the queue
+	osd_work_queue *    m_queue = nullptr;
+};
+
+shared_work_queue s_work_queue;
+
+} // anonymous namespace
+
+
 /*-------------------------------------------------
     write_png_stream - stream a series of PNG
     chunks to the given file
@@ -1011,6 +1522,8 @@ static png_error write_png_stream(util::core_file &fp, png_info *pnginfo, const
 	uint8_t tempbuff[16];
 	png_text *text;
 	png_error error;
+	osd_work_queue *queue = nullptr;
+	int strategy = Z_DEFAULT_STRATEGY;
 
 	/* create an unfiltered image in either palette or RGB form */
 	if (bitmap.format() == BITMAP_FORMAT_IND16 && palette_length <= 256)
@@ -1020,7 +1533,20 @@ static png_error write_png_stream(util::core_file &fp, png_info *pnginfo, const
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
-	/* if we wanted to get clever and do filtering, we would do it here */
+	/* big images spread the filtering and deflating over the shared work queue */
+	if (pnginfo->height * (compute_rowbytes(pnginfo) + 1) >= PARALLEL_THRESHOLD)
+		queue = s_work_queue.acquire();
+
+	/* filter truecolour images with lots of colours; images with few colours,
+	   like most native snapshots, compress better left alone, and filtered
+	   data is mostly runs, which run-length matching finds much faster */
+	if (pnginfo->color_type != 3 && !has_few_colours(pnginfo))
+	{
+		error = filter_image(pnginfo, queue);
+		if (error != PNGERR_NONE)
+			goto handle_error;
+		strategy = Z_RLE;
+	}
 
 	/* write the IHDR chunk */
 	put_32bit(tempbuff + 0, pnginfo->width);
@@ -1041,7 +1567,7 @@ static png_error write_png_stream(util::core_file &fp, png_info *pnginfo, const
 		goto handle_error;
 
 	/* write a single IDAT chunk */
-	error = write_deflated_chunk(fp, pnginfo->image, PNG_CN_IDAT, pnginfo->height * (compute_rowbytes(pnginfo) + 1));
+	error = write_deflated_chunk(fp, pnginfo->image, PNG_CN_IDAT, pnginfo->height * (compute_rowbytes(pnginfo) + 1), strategy, queue);
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
@@ -1057,6 +1583,7 @@ static png_error write_png_stream(util::core_file &fp, png_info *pnginfo, const
 	error = write_chunk(fp, nullptr, PNG_CN_IEND, 0);
 
 handle_error:
+	s_work_queue.release(queue);
 	return error;
 }
 
@@ -0,0 +1,512 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    tracefile.cpp
+
+    Compact binary instruction trace files.
+
+***************************************************************************/
+
+#include "tracefile.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace util {
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+static const char TRACE_SIGNATURE[8] = { 'M', 'A', 'M', 'E', 'T', 'R', 'C', 0 };
+static constexpr std::uint32_t TRACE_VERSION = 1;
+static constexpr std::uint32_t MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+
+// write_block results
+static const char COMPRESS_ERROR[] = "error compressing trace block";
+static const char WRITE_ERROR[] = "error writing trace file";
+
+
+
+/***************************************************************************
+    HELPERS
+***************************************************************************/
+
+static void put_u32(std::uint8_t *dest, std::uint32_t data)
+{
+	dest[0] = data;
+	dest[1] = data >> 8;
+	dest[2] = data >> 16;
+	dest[3] = data >> 24;
+}
+
+static std::uint32_t get_u32(const std::uint8_t *src)
+{
+	return src[0] | (src[1] << 8) | (src[2] << 16) | (std::uint32_t(src[3]) << 24);
+}
+
+
+
+/***************************************************************************
+    TRACE WRITER
+***************************************************************************/
+
+/*-------------------------------------------------
+    trace_writer - write the signature and start
+    the writer thread; a single I/O thread keeps
+    the blocks in order
+-------------------------------------------------*/
+
+trace_writer::trace_writer(FILE &file)
+	: m_file(file)
+	, m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO))
+	, m_block(std::make_unique<block>())
+	, m_last_pc(0)
+	, m_failed(false)
+{
+	std::uint8_t header[sizeof(TRACE_SIGNATURE) + 4];
+	memcpy(header, TRACE_SIGNATURE, sizeof(TRACE_SIGNATURE));
+	put_u32(&header[sizeof(TRACE_SIGNATURE)], TRACE_VERSION);
+	if (fwrite(header, 1, sizeof(header), &m_file) != sizeof(header))
+		set_error(WRITE_ERROR);
+
+	m_block->raw.reserve(BLOCK_SIZE);
+}
+
+
+/*-------------------------------------------------
+    ~trace_writer - write out the last block
+-------------------------------------------------*/
+
+trace_writer::~trace_writer()
+{
+	flush();
+	if (m_queue != nullptr)
+		osd_work_queue_free(m_queue);
+}
+
+
+/*-------------------------------------------------
+    records
+-------------------------------------------------*/
+
+void trace_writer::device(std::uint32_t flags, const char *shortname, const char *tag)
+{
+	reserve(MAX_RECORD + strlen(shortname) + strlen(tag));
+	put_byte(std::uint8_t(trace_record::DEVICE));
+	put_varint(flags);
+	put_string(shortname, strlen(shortname));
+	put_string(tag, strlen(tag));
+}
+
+void trace_writer::register_name(std::uint32_t slot, const char *name)
+{
+	reserve(MAX_RECORD + strlen(name));
+	put_byte(std::uint8_t(trace_record::REGISTER_NAME));
+	put_varint(slot);
+	put_string(name, strlen(name));
+}
+
+void trace_writer::opcode(std::uint64_t pc, const std::uint8_t *opcodes, const std::uint8_t *arguments, unsigned length)
+{
+	reserve(MAX_RECORD);
+	put_byte(std::uint8_t(trace_record::OPCODE));
+	put_varint(pc);
+	put_byte(length);
+	m_block->raw.insert(m_block->raw.end(), opcodes, opcodes + length);
+	if (arguments != nullptr)
+		m_block->raw.insert(m_block->raw.end(), arguments, arguments + length);
+}
+
+void trace_writer::instruction(std::uint64_t pc)
+{
+	// PCs are stored as a zigzag-encoded delta from the previous one
+	reserve(MAX_RECORD);
+	std::uint64_t const delta = pc - m_last_pc;
+	put_byte(std::uint8_t(trace_record::INSTRUCTION));
+	put_varint((delta << 1) ^ -(delta >> 63));
+	m_last_pc = pc;
+}
+
+void trace_writer::register_value(std::uint32_t slot, std::uint64_t value)
+{
+	reserve(MAX_RECORD);
+	put_byte(std::uint8_t(trace_record::REGISTER));
+	put_varint(slot);
+	put_varint(value);
+}
+
+void trace_writer::memory_read(unsigned space, std::uint64_t address, std::uint64_t mask)
+{
+	reserve(MAX_RECORD);
+	put_byte(std::uint8_t(trace_record::READ));
+	put_byte(space);
+	put_varint(address);
+	put_varint(mask);
+}
+
+void trace_writer::memory_write(unsigned space, std::uint64_t address, std::uint64_t data, std::uint64_t mask)
+{
+	reserve(MAX_RECORD);
+	put_byte(std::uint8_t(trace_record::WRITE));
+	put_byte(space);
+	put_varint(address);
+	put_varint(data);
+	put_varint(mask);
+}
+
+void trace_writer::text(const char *text, std::size_t length)
+{
+	// split long text so a record always fits in a block
+	do
+	{
+		std::size_t const chunk = std::min<std::size_t>(length, BLOCK_SIZE / 2);
+		reserve(MAX_RECORD + chunk);
+		put_byte(std::uint8_t(trace_record::TEXT));
+		put_string(text, chunk);
+		text += chunk;
+		length -= chunk;
+	}
+	while (length != 0);
+}
+
+
+/*-------------------------------------------------
+    flush - hand over the current block and wait
+    for everything to reach the file
+-------------------------------------------------*/
+
+void trace_writer::flush()
+{
+	submit();
+	wait(0);
+	if (fflush(&m_file) != 0)
+		set_error(WRITE_ERROR);
+}
+
+
+/*-------------------------------------------------
+    put_varint - append an unsigned LEB128 value
+-------------------------------------------------*/
+
+void trace_writer::put_varint(std::uint64_t data)
+{
+	while (data >= 0x80)
+	{
+		put_byte(std::uint8_t(data) | 0x80);
+		data >>= 7;
+	}
+	put_byte(std::uint8_t(data));
+}
+
+
+/*-------------------------------------------------
+    put_string - append a length-prefixed string
+-------------------------------------------------*/
+
+void trace_writer::put_string(const char *string, std::size_t length)
+{
+	put_varint(length);
+	m_block->raw.insert(m_block->raw.end(), string, string + length);
+}
+
+
+/*-------------------------------------------------
+    submit - queue the current block for writing
+    and start a new one
+-------------------------------------------------*/
+
+void trace_writer::submit()
+{
+	if (m_block->raw.empty())
+		return;
+
+	// don't let the writer fall too far behind
+	wait(MAX_PENDING - 1);
+
+	// each block stands alone, so restart the PC deltas
+	m_block->file = &m_file;
+	m_block->failed = &m_failed;
+	m_last_pc = 0;
+	block *const item = m_block.release();
+	m_block = std::make_unique<block>();
+	m_block->raw.reserve(BLOCK_SIZE);
+
+	osd_work_item *const work = (m_queue != nullptr) ? osd_work_item_queue(m_queue, write_block, item, 0) : nullptr;
+	if (work != nullptr)
+		m_pending.push_back(work);
+	else
+		set_error(write_block(item, 0));
+}
+
+
+/*-------------------------------------------------
+    wait - wait until no more than the given
+    number of blocks are outstanding
+-------------------------------------------------*/
+
+void trace_writer::wait(std::size_t pending)
+{
+	while (m_pending.size() > pending)
+	{
+		osd_work_item_wait(m_pending.front(), 100 * osd_ticks_per_second());
+		set_error(osd_work_item_result(m_pending.front()));
+		osd_work_item_release(m_pending.front());
+		m_pending.pop_front();
+	}
+}
+
+
+/*-------------------------------------------------
+    set_error - remember the first error a block
+    reported
+-------------------------------------------------*/
+
+void trace_writer::set_error(const void *result)
+{
+	if (result != nullptr)
+	{
+		m_failed = true;
+		if (m_error.empty())
+			m_error = reinterpret_cast<const char *>(result);
+	}
+}
+
+
+/*-------------------------------------------------
+    write_block - deflate and write one block;
+    returns an error message on failure, and
+    once a block has failed the rest are dropped
+    so the file stays readable up to that point
+-------------------------------------------------*/
+
+void *trace_writer::write_block(void *param, int threadid)
+{
+	std::unique_ptr<block> const item(reinterpret_cast<block *>(param));
+	if (*item->failed)
+		return nullptr;
+
+	uLongf length = compressBound(item->raw.size());
+	item->compressed.resize(8 + length);
+	if (compress2(&item->compressed[8], &length, &item->raw[0], item->raw.size(), Z_BEST_SPEED) != Z_OK)
+	{
+		*item->failed = true;
+		return const_cast<char *>(COMPRESS_ERROR);
+	}
+
+	put_u32(&item->compressed[0], length);
+	put_u32(&item->compressed[4], item->raw.size());
+	if (fwrite(&item->compressed[0], 1, 8 + length, item->file) != 8 + length)
+	{
+		*item->failed = true;
+		return const_cast<char *>(WRITE_ERROR);
+	}
+	return nullptr;
+}
+
+
+
+/***************************************************************************
+    TRACE READER
+***************************************************************************/
+
+/*-------------------------------------------------
+    trace_reader - constructor
+-------------------------------------------------*/
+
+trace_reader::trace_reader(FILE &file)
+	: m_file(file)
+	, m_offset(0)
+	, m_last_pc(0)
+	, m_arguments(false)
+	, m_started(false)
+{
+}
+
+
+/*-------------------------------------------------
+    next - decode the next record
+-------------------------------------------------*/
+
+bool trace_reader::next(trace_entry &entry)
+{
+	// check the signature first
+	if (!m_started)
+	{
+		std::uint8_t header[sizeof(TRACE_SIGNATURE) + 4];
+		if (fread(header, 1, sizeof(header), &m_file) != sizeof(header) || memcmp(header, TRACE_SIGNATURE, sizeof(TRACE_SIGNATURE)))
+		{
+			m_error = "not a trace file";
+			return false;
+		}
+		if (get_u32(&header[sizeof(TRACE_SIGNATURE)]) != TRACE_VERSION)
+		{
+			m_error = "unsupported trace file version";
+			return false;
+		}
+		m_started = true;
+	}
+
+	// move on to the next block when this one runs out
+	if (m_offset >= m_block.size() && !read_block())
+		return false;
+
+	std::uint8_t type, byte;
+	std::uint64_t value;
+	bool ok = get_byte(type);
+	entry.type = trace_record(type);
+	switch (entry.type)
+	{
+		case trace_record::DEVICE:
+			ok = ok && get_varint(value) && get_string(entry.text) && get_string(entry.tag);
+			entry.index = value;
+			m_arguments = (value & TRACE_FLAG_ARGUMENTS) != 0;
+			break;
+
+		case trace_record::REGISTER_NAME:
+			ok = ok && get_varint(value) && get_string(entry.text);
+			entry.index = value;
+			break;
+
+		case trace_record::OPCODE:
+			ok = ok && get_varint(entry.address) && get_byte(byte) && get_bytes(entry.opcodes, byte);
+			if (m_arguments)
+				ok = ok && get_bytes(entry.arguments, byte);
+			else
+				entry.arguments = entry.opcodes;
+			break;
+
+		case trace_record::INSTRUCTION:
+			ok = ok && get_varint(value);
+			m_last_pc += (value >> 1) ^ -(value & 1);
+			entry.address = m_last_pc;
+			break;
+
+		case trace_record::REGISTER:
+			ok = ok && get_varint(value) && get_varint(entry.data);
+			entry.index = value;
+			break;
+
+		case trace_record::READ:
+			ok = ok && get_byte(byte) && get_varint(entry.address) && get_varint(entry.mask);
+			entry.index = byte;
+			break;
+
+		case trace_record::WRITE:
+			ok = ok && get_byte(byte) && get_varint(entry.address) && get_varint(entry.data) && get_varint(entry.mask);
+			entry.index = byte;
+			break;
+
+		case trace_record::TEXT:
+			ok = ok && get_string(entry.text);
+			break;
+
+		default:
+			ok = false;
+			break;
+	}
+
+	if (!ok)
+	{
+		m_error = "corrupt trace record";
+		return false;
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    read_block - read and inflate the next block
+-------------------------------------------------*/
+
+bool trace_reader::read_block()
+{
+	std::uint8_t header[8];
+	std::size_t const actual = fread(header, 1, sizeof(header), &m_file);
+	if (actual == 0)
+		return false;
+	if (actual != sizeof(header))
+	{
+		m_error = "truncated trace file";
+		return false;
+	}
+
+	std::uint32_t const complength = get_u32(&header[0]);
+	uLongf rawlength = get_u32(&header[4]);
+	if (complength > MAX_BLOCK_SIZE || rawlength > MAX_BLOCK_SIZE || rawlength == 0)
+	{
+		m_error = "corrupt trace block";
+		return false;
+	}
+
+	std::vector<std::uint8_t> compressed(complength);
+	if (fread(&compressed[0], 1, complength, &m_file) != complength)
+	{
+		m_error = "truncated trace file";
+		return false;
+	}
+
+	uLongf const expected = rawlength;
+	m_block.resize(rawlength);
+	if (uncompress(&m_block[0], &rawlength, &compressed[0], complength) != Z_OK || rawlength != expected)
+	{
+		m_error = "corrupt trace block";
+		return false;
+	}
+	m_offset = 0;
+	m_last_pc = 0;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    field decoders
+-------------------------------------------------*/
+
+bool trace_reader::get_byte(std::uint8_t &data)
+{
+	if (m_offset >= m_block.size())
+		return false;
+	data = m_block[m_offset++];
+	return true;
+}
+
+bool trace_reader::get_varint(std::uint64_t &data)
+{
+	data = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		std::uint8_t byte;
+		if (!get_byte(byte))
+			return false;
+		data |= std::uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+bool trace_reader::get_string(std::string &string)
+{
+	std::uint64_t length;
+	if (!get_varint(length) || length > m_block.size() - m_offset)
+		return false;
+	string.assign(reinterpret_cast<const char *>(&m_block[m_offset]), length);
+	m_offset += length;
+	return true;
+}
+
+bool trace_reader::get_bytes(std::vector<std::uint8_t> &bytes, std::size_t length)
+{
+	if (length > m_block.size() - m_offset)
+		return false;
+	bytes.assign(m_block.begin() + m_offset, m_block.begin() + m_offset + length);
+	m_offset += length;
+	return true;
+}
+
+} // namespace util
@@ -0,0 +1,166 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    tracefile.h
+
+    Compact binary instruction trace files.
+
+    A trace file is an eight-byte signature and a version number followed
+    by deflated blocks, each prefixed with its compressed and raw lengths.
+    Every block holds a whole number of records, so a truncated file still
+    decodes up to its last complete block.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_LIB_UTIL_TRACEFILE_H
+#define MAME_LIB_UTIL_TRACEFILE_H
+
+#include "osdcore.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace util {
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+// record types
+enum class trace_record : std::uint8_t
+{
+	END = 0,
+	DEVICE,             // traced device: flags, short name, tag
+	REGISTER_NAME,      // register slot and name
+	OPCODE,             // PC and the opcode bytes found there
+	INSTRUCTION,        // an instruction was executed at PC
+	REGISTER,           // register slot and its new value
+	READ,               // memory read: space, address, mask
+	WRITE,              // memory write: space, address, data, mask
+	TEXT                // free-form text
+};
+
+
+// device flags
+constexpr std::uint32_t TRACE_FLAG_ARGUMENTS = 0x0001;  // OPCODE records carry separate argument bytes
+
+
+// a decoded record
+struct trace_entry
+{
+	trace_record                type;
+	std::uint64_t               address;    // PC or memory address
+	std::uint64_t               data;       // register value or memory data
+	std::uint64_t               mask;       // memory mask
+	std::uint32_t               index;      // register slot, address space or device flags
+	std::vector<std::uint8_t>   opcodes;    // opcode bytes
+	std::vector<std::uint8_t>   arguments;  // argument bytes, if the device has them
+	std::string                 text;       // text, device short name or register name
+	std::string                 tag;        // device tag
+};
+
+
+// ======================> trace_writer
+
+// encodes records into blocks, and deflates and writes them on a
+// background thread
+class trace_writer
+{
+public:
+	// construction/destruction
+	trace_writer(FILE &file);
+	~trace_writer();
+
+	// records
+	void device(std::uint32_t flags, const char *shortname, const char *tag);
+	void register_name(std::uint32_t slot, const char *name);
+	void opcode(std::uint64_t pc, const std::uint8_t *opcodes, const std::uint8_t *arguments, unsigned length);
+	void instruction(std::uint64_t pc);
+	void register_value(std::uint32_t slot, std::uint64_t value);
+	void memory_read(unsigned space, std::uint64_t address, std::uint64_t mask);
+	void memory_write(unsigned space, std::uint64_t address, std::uint64_t data, std::uint64_t mask);
+	void text(const char *text, std::size_t length);
+
+	// write out everything recorded so far; error() describes the first
+	// block that could not be written, after which nothing more is written
+	void flush();
+	const std::string &error() const { return m_error; }
+
+private:
+	static constexpr std::size_t BLOCK_SIZE = 256 * 1024;   // raw bytes per block
+	static constexpr std::size_t MAX_RECORD = 1024;         // largest record, besides text
+	static constexpr std::size_t MAX_PENDING = 8;           // blocks in flight before recording waits
+
+	struct block
+	{
+		FILE *                      file;
+		std::atomic<bool> *         failed;
+		std::vector<std::uint8_t>   raw;
+		std::vector<std::uint8_t>   compressed;
+	};
+
+	// internal helpers
+	void reserve(std::size_t bytes) { if (m_block->raw.size() + bytes > BLOCK_SIZE) submit(); }
+	void put_byte(std::uint8_t data) { m_block->raw.push_back(data); }
+	void put_varint(std::uint64_t data);
+	void put_string(const char *string, std::size_t length);
+	void submit();
+	void wait(std::size_t pending);
+	void set_error(const void *result);
+	static void *write_block(void *param, int threadid);
+
+	// internal state
+	FILE &                      m_file;
+	osd_work_queue *            m_queue;
+	std::deque<osd_work_item *> m_pending;
+	std::unique_ptr<block>      m_block;
+	std::uint64_t               m_last_pc;
+	std::atomic<bool>           m_failed;
+	std::string                 m_error;
+};
+
+
+// ======================> trace_reader
+
+// reads records back from a trace file
+class trace_reader
+{
+public:
+	// construction/destruction
+	trace_reader(FILE &file);
+
+	// read the next record; returns false at the end of the file, with
+	// error() describing anything that stopped it early
+	bool next(trace_entry &entry);
+	const std::string &error() const { return m_error; }
+
+private:
+	// internal helpers
+	bool read_block();
+	bool get_byte(std::uint8_t &data);
+	bool get_varint(std::uint64_t &data);
+	bool get_string(std::string &string);
+	bool get_bytes(std::vector<std::uint8_t> &bytes, std::size_t length);
+
+	// internal state
+	FILE &                      m_file;
+	std::vector<std::uint8_t>   m_block;
+	std::size_t                 m_offset;
+	std::uint64_t               m_last_pc;
+	bool                        m_arguments;
+	bool                        m_started;
+	std::string                 m_error;
+};
+
+} // namespace util
+
+#endif // MAME_LIB_UTIL_TRACEFILE_H
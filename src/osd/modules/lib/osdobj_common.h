@@ -43,6 +43,7 @@
 
 #define OSDOPTION_NUMPROCESSORS         "numprocessors"
 #define OSDOPTION_BENCH                 "bench"
+#define OSDOPTION_SWBANDS               "swbands"
 
 #define OSDOPTION_VIDEO                 "video"
 #define OSDOPTION_NUMSCREENS            "numscreens"
@@ -112,6 +113,7 @@ public:
 	// performance options
 	const char *numprocessors() const { return value(OSDOPTION_NUMPROCESSORS); }
 	int bench() const { return int_value(OSDOPTION_BENCH); }
+	int sw_bands() const { return int_value(OSDOPTION_SWBANDS); }
 
 	// video options
 	const char *video() const { return value(OSDOPTION_VIDEO); }
@@ -260,6 +260,7 @@ struct osd_video_config
 	int                 waitvsync;                  // spin until vsync
 	int                 syncrefresh;                // sync only to refresh rate
 	int                 switchres;                  // switch resolutions
+	int                 swbands;                    // bands drawn in parallel by software renderers
 
 	// d3d, accel, opengl
 	int                 filter;                     // enable filtering
@@ -19,6 +19,10 @@ renderer_gdi::~renderer_gdi()
 	// free the bitmap memory
 	if (m_bmdata != nullptr)
 		global_free_array(m_bmdata);
+
+	// free the band work queue
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
 }
 
 //============================================================
@@ -37,6 +41,10 @@ int renderer_gdi::create()
 	m_bminfo.bmiHeader.biYPelsPerMeter   = 0;
 	m_bminfo.bmiHeader.biClrUsed         = 0;
 	m_bminfo.bmiHeader.biClrImportant    = 0;
+
+	// draw in bands on a work queue if requested
+	if (video_config.swbands > 1)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 	return 0;
 }
 
@@ -83,11 +91,19 @@ int renderer_gdi::draw(const int update)
 		m_bmsize = pitch * height * 4 * 2;
 		global_free_array(m_bmdata);
 		m_bmdata = global_alloc_array(uint8_t, m_bmsize);
+		m_drawn_width = m_drawn_height = 0;
 	}
 
-	// draw the primitives to the bitmap
+	// draw the primitives to the bitmap, unless it already holds this list or
+	// an identical one drawn at the same size
 	win->m_primlist->acquire_lock();
-	software_renderer<uint32_t, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, m_bmdata, width, height, pitch);
+	const render_primitive_list &primlist = *win->m_primlist;
+	bool const unchanged = (primlist.serial() == m_drawn_serial) || (primlist.serial() == m_drawn_serial + 1 && primlist.changes() == 0);
+	if (!unchanged || width != m_drawn_width || height != m_drawn_height)
+		software_renderer<uint32_t, 0,0,0, 16,8,0>::draw_primitives(primlist, m_bmdata, width, height, pitch, m_work_queue, video_config.swbands);
+	m_drawn_serial = primlist.serial();
+	m_drawn_width = width;
+	m_drawn_height = height;
 	win->m_primlist->release_lock();
 
 	// fill in bitmap-specific info
@@ -31,6 +31,10 @@ public:
 		: osd_renderer(window, FLAG_NONE)
 		, m_bmdata(nullptr)
 		, m_bmsize(0)
+		, m_work_queue(nullptr)
+		, m_drawn_serial(0)
+		, m_drawn_width(0)
+		, m_drawn_height(0)
 	{
 	}
 	virtual ~renderer_gdi();
@@ -50,6 +54,10 @@ private:
 	BITMAPINFO              m_bminfo;
 	uint8_t *                 m_bmdata;
 	size_t                  m_bmsize;
+	osd_work_queue *        m_work_queue;
+	uint32_t                m_drawn_serial;         // serial number of the list in m_bmdata
+	int                     m_drawn_width;          // size m_bmdata was drawn at
+	int                     m_drawn_height;
 };
 
 #endif // __DRAWGDI__
@@ -245,6 +245,10 @@ int renderer_sdl1::create()
 	m_blittimer = 0;
 
 	yuv_init();
+
+	// draw in bands on a work queue if requested
+	if (video_config.swbands > 1)
+		m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 	osd_printf_verbose("Leave renderer_sdl2::create\n");
 	return 0;
 }
@@ -267,6 +271,8 @@ renderer_sdl1::~renderer_sdl1()
 		global_free_array(m_yuv_bitmap);
 		m_yuv_bitmap = nullptr;
 	}
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
 	SDL_DestroyRenderer(m_sdl_renderer);
 }
 
@@ -416,23 +422,23 @@ int renderer_sdl1::draw(int update)
 		switch (rmask)
 		{
 			case 0x0000ff00:
-				software_renderer<uint32_t, 0,0,0, 8,16,24>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4);
+				software_renderer<uint32_t, 0,0,0, 8,16,24>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4, m_work_queue, video_config.swbands);
 				break;
 
 			case 0x00ff0000:
-				software_renderer<uint32_t, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4);
+				software_renderer<uint32_t, 0,0,0, 16,8,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4, m_work_queue, video_config.swbands);
 				break;
 
 			case 0x000000ff:
-				software_renderer<uint32_t, 0,0,0, 0,8,16>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4);
+				software_renderer<uint32_t, 0,0,0, 0,8,16>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 4, m_work_queue, video_config.swbands);
 				break;
 
 			case 0xf800:
-				software_renderer<uint16_t, 3,2,3, 11,5,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 2);
+				software_renderer<uint16_t, 3,2,3, 11,5,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 2, m_work_queue, video_config.swbands);
 				break;
 
 			case 0x7c00:
-				software_renderer<uint16_t, 3,3,3, 10,5,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 2);
+				software_renderer<uint16_t, 3,3,3, 10,5,0>::draw_primitives(*win->m_primlist, surfptr, mamewidth, mameheight, pitch / 2, m_work_queue, video_config.swbands);
 				break;
 
 			default:
@@ -444,7 +450,7 @@ int renderer_sdl1::draw(int update)
 	{
 		assert (m_yuv_bitmap != nullptr);
 		assert (surfptr != nullptr);
-		software_renderer<uint16_t, 3,3,3, 10,5,0>::draw_primitives(*win->m_primlist, m_yuv_bitmap, mamewidth, mameheight, mamewidth);
+		software_renderer<uint16_t, 3,3,3, 10,5,0>::draw_primitives(*win->m_primlist, m_yuv_bitmap, mamewidth, mameheight, mamewidth, m_work_queue, video_config.swbands);
 		sm->yuv_blit((uint16_t *)m_yuv_bitmap, surfptr, pitch, m_yuv_lookup, mamewidth, mameheight);
 	}
 
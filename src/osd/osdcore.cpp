@@ -4,9 +4,13 @@
 #include "osdcore.h"
 #include <thread>
 #include <chrono>
+#include <type_traits>
 
 #if defined(SDLMAME_ANDROID)
 #include <SDL2/SDL.h>
+#elif defined(__linux__)
+#include <errno.h>
+#include <time.h>
 #endif
 static const int MAXSTACK = 10;
 static osd_output *m_stack[MAXSTACK];
@@ -194,3 +198,24 @@ void osd_sleep(osd_ticks_t duration)
 {
 	std::this_thread::sleep_for(std::chrono::high_resolution_clock::duration(duration));
 }
+
+//============================================================
+//  osd_sleep_until
+//============================================================
+
+void osd_sleep_until(osd_ticks_t target)
+{
+	typedef std::chrono::high_resolution_clock clock;
+#if defined(__linux__) && !defined(SDLMAME_ANDROID)
+	// an absolute sleep on the clock osd_ticks reads, so time spent getting
+	// here doesn't push the wakeup later
+	clockid_t const clockid = std::is_same<clock, std::chrono::steady_clock>::value ? CLOCK_MONOTONIC : CLOCK_REALTIME;
+	auto const nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::duration(target)).count();
+	timespec deadline;
+	deadline.tv_sec = nanoseconds / 1000000000;
+	deadline.tv_nsec = nanoseconds % 1000000000;
+	while (clock_nanosleep(clockid, TIMER_ABSTIME, &deadline, nullptr) == EINTR) { }
+#else
+	std::this_thread::sleep_until(clock::time_point(clock::duration(target)));
+#endif
+}
@@ -471,6 +471,29 @@ osd_ticks_t osd_ticks_per_second(void);
 -----------------------------------------------------------------------------*/
 void osd_sleep(osd_ticks_t duration);
 
+
+/*-----------------------------------------------------------------------------
+    osd_sleep_until: sleep until the specified absolute time
+
+    Parameters:
+
+        target - an osd_ticks_t value, on the same timebase as osd_ticks,
+            at which we should wake up
+
+    Return value:
+
+        None
+
+    Notes:
+
+        Unlike osd_sleep, the wakeup is tied to the deadline rather than
+        to the moment of the call, so repeated sleeps don't accumulate
+        drift. The OSD layer should wake as soon after the deadline as it
+        can; callers needing precise timing should aim early and spin
+        for the remainder.
+-----------------------------------------------------------------------------*/
+void osd_sleep_until(osd_ticks_t target);
+
 /***************************************************************************
     WORK ITEM INTERFACES
 ***************************************************************************/
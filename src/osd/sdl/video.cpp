@@ -240,6 +240,7 @@ void sdl_osd_interface::extract_video_config()
 	video_config.centerv       = options().centerv();
 	video_config.waitvsync     = options().wait_vsync();
 	video_config.syncrefresh   = options().sync_refresh();
+	video_config.swbands       = options().sw_bands();
 	if (!video_config.waitvsync && video_config.syncrefresh)
 	{
 		osd_printf_warning("-syncrefresh specified without -waitvsync. Reverting to -nosyncrefresh\n");
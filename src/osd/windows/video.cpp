@@ -183,6 +183,7 @@ void windows_osd_interface::extract_video_config()
 	}
 	video_config.waitvsync     = options().wait_vsync();
 	video_config.syncrefresh   = options().sync_refresh();
+	video_config.swbands       = options().sw_bands();
 	video_config.triplebuf     = options().triple_buffer();
 	video_config.switchres     = options().switch_res();
 
@@ -10,9 +10,11 @@
 
 #include "emu.h"
 #include "cpu/sparc/sparcdasm.h"
+#include "tracefile.h"
 
 #include <algorithm>
 #include <cstring>
+#include <unordered_map>
 
 #include <ctype.h>
 
@@ -59,6 +61,9 @@ struct options
 	const dasm_table_entry *dasm;
 	uint32_t                  skip;
 	uint32_t                  count;
+	uint8_t                   trace;
+	uint8_t                   findpc;
+	offs_t                  pc;
 };
 
 
@@ -412,6 +417,7 @@ static int parse_options(int argc, char *argv[], options *opts)
 	bool pending_mode = false;
 	bool pending_skip = false;
 	bool pending_count = false;
+	bool pending_pc = false;
 
 	memset(opts, 0, sizeof(*opts));
 
@@ -423,7 +429,7 @@ static int parse_options(int argc, char *argv[], options *opts)
 		// is it a switch?
 		if (curarg[0] == '-')
 		{
-			if (pending_base || pending_arch || pending_mode || pending_skip || pending_count)
+			if (pending_base || pending_arch || pending_mode || pending_skip || pending_count || pending_pc)
 				goto usage;
 
 			if (tolower((uint8_t)curarg[1]) == 'a')
@@ -444,6 +450,10 @@ static int parse_options(int argc, char *argv[], options *opts)
 				opts->norawbytes = true;
 			else if (tolower((uint8_t)curarg[1]) == 'u')
 				opts->upper = true;
+			else if (tolower((uint8_t)curarg[1]) == 't')
+				opts->trace = true;
+			else if (tolower((uint8_t)curarg[1]) == 'p')
+				pending_pc = true;
 			else
 				goto usage;
 		}
@@ -463,6 +473,15 @@ static int parse_options(int argc, char *argv[], options *opts)
 			pending_base = false;
 		}
 
+		// PC to find in a trace
+		else if (pending_pc)
+		{
+			if (sscanf(curarg, "%x", &opts->pc) != 1)
+				goto usage;
+			opts->findpc = true;
+			pending_pc = false;
+		}
+
 		// mode
 		else if (pending_mode)
 		{
@@ -510,11 +529,11 @@ static int parse_options(int argc, char *argv[], options *opts)
 	}
 
 	// if we have a dangling option, error
-	if (pending_base || pending_arch || pending_mode || pending_skip || pending_count)
+	if (pending_base || pending_arch || pending_mode || pending_skip || pending_count || pending_pc)
 		goto usage;
 
-	// if no file or no architecture, fail
-	if (opts->filename == nullptr || opts->dasm == nullptr)
+	// if no file or no architecture, fail; traces name their own device
+	if (opts->filename == nullptr || (opts->dasm == nullptr && !opts->trace))
 		goto usage;
 	return 0;
 
@@ -523,6 +542,10 @@ usage:
 	printf("   [-mode <n>] [-norawbytes] [-flipped] [-upper] [-lower]\n");
 	printf("   [-skip <n>] [-count <n>]\n");
 	printf("\n");
+	printf("Binary traces: %s <filename> -trace [-arch <architecture>] [-mode <n>]\n", argv[0]);
+	printf("   [-pc <pc>] [-norawbytes] [-upper] [-lower] [-skip <n>] [-count <n>]\n");
+	printf("   -arch is optional here; it overrides the architecture named in the trace\n");
+	printf("\n");
 	printf("Supported architectures:");
 	const int colwidth = 1 + std::strlen(std::max_element(std::begin(dasm_table), std::end(dasm_table), [](const dasm_table_entry &a, const dasm_table_entry &b) { return std::strlen(a.name) < std::strlen(b.name); })->name);
 	const int columns = std::max(1, 80 / colwidth);
@@ -541,6 +564,137 @@ usage:
 };
 
 
+static void transform_case(const options &opts, std::string &buffer)
+{
+	if (opts.lower)
+		std::transform(std::begin(buffer), std::end(buffer), std::begin(buffer), [](char c) { return tolower(c); });
+	else if (opts.upper)
+		std::transform(std::begin(buffer), std::end(buffer), std::begin(buffer), [](char c) { return toupper(c); });
+}
+
+
+static int trace_main(options &opts)
+{
+	static const char *const spacenames[] = { "program", "data", "io", "opcodes" };
+
+	FILE *const file = fopen(opts.filename, "rb");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Error opening file '%s'\n", opts.filename);
+		return 1;
+	}
+
+	util::trace_reader reader(*file);
+	util::trace_entry entry;
+	std::unordered_map<offs_t, std::pair<std::vector<uint8_t>, std::vector<uint8_t>>> opcodes;
+	std::vector<std::string> registers;
+	uint64_t instructions = 0;
+	bool show = !opts.findpc && opts.skip == 0;
+	std::stringstream stream;
+
+	while (reader.next(entry))
+	{
+		switch (entry.type)
+		{
+			case util::trace_record::DEVICE:
+				// pick the disassembler from the device unless one was asked for
+				if (opts.dasm == nullptr)
+					for (auto &dasm : dasm_table)
+						if (!core_stricmp(dasm.name, entry.text.c_str()))
+							opts.dasm = &dasm;
+				printf("; tracing %s (%s)%s\n", entry.tag.c_str(), entry.text.c_str(), (opts.dasm == nullptr) ? ", no disassembler" : "");
+				break;
+
+			case util::trace_record::REGISTER_NAME:
+				if (registers.size() <= entry.index)
+					registers.resize(entry.index + 1);
+				registers[entry.index] = entry.text;
+				break;
+
+			case util::trace_record::OPCODE:
+			{
+				// pad so the disassembler can't run off the end
+				auto &bytes = opcodes[entry.address];
+				bytes.first = entry.opcodes;
+				bytes.second = entry.arguments;
+				bytes.first.resize(std::max<size_t>(bytes.first.size(), 64));
+				bytes.second.resize(std::max<size_t>(bytes.second.size(), 64));
+				break;
+			}
+
+			case util::trace_record::INSTRUCTION:
+			{
+				offs_t const pc = entry.address;
+				instructions++;
+				if (opts.count != 0 && instructions > uint64_t(opts.skip) + opts.count)
+					goto done;
+				show = instructions > opts.skip && (!opts.findpc || pc == opts.pc);
+				if (!show)
+					break;
+
+				std::string buffer;
+				uint32_t length = 0;
+				auto const found = opcodes.find(pc);
+				if (found != opcodes.end() && opts.dasm != nullptr)
+				{
+					stream.str("");
+					length = (*opts.dasm->func)(nullptr, stream, pc, &found->second.first[0], &found->second.second[0], opts.mode) & DASMFLAG_LENGTHMASK;
+					if (opts.dasm->pcshift < 0)
+						length <<= -opts.dasm->pcshift;
+					else
+						length >>= opts.dasm->pcshift;
+					buffer = stream.str();
+					transform_case(opts, buffer);
+				}
+
+				printf("%10u  %08X: ", unsigned(instructions - 1), pc);
+				if (!opts.norawbytes && found != opcodes.end())
+				{
+					uint32_t const rawbytes = std::min<uint32_t>(length ? length : 1, 8);
+					for (uint32_t bytenum = 0; bytenum < 8; bytenum++)
+						printf((bytenum < rawbytes) ? "%02X" : "  ", found->second.first[bytenum]);
+					printf("  ");
+				}
+				printf("%s\n", buffer.c_str());
+				break;
+			}
+
+			case util::trace_record::REGISTER:
+				if (show)
+					printf("%s", string_format("%24s%s=%X\n", "", (entry.index < registers.size()) ? registers[entry.index] : "?", entry.data).c_str());
+				break;
+
+			case util::trace_record::READ:
+				if (show)
+					printf("%s", string_format("%24sread  %s:%X & %X\n", "", (entry.index < ARRAY_LENGTH(spacenames)) ? spacenames[entry.index] : "?", entry.address, entry.mask).c_str());
+				break;
+
+			case util::trace_record::WRITE:
+				if (show)
+					printf("%s", string_format("%24swrite %s:%X = %X & %X\n", "", (entry.index < ARRAY_LENGTH(spacenames)) ? spacenames[entry.index] : "?", entry.address, entry.data, entry.mask).c_str());
+				break;
+
+			case util::trace_record::TEXT:
+				if (show)
+					printf("%s", entry.text.c_str());
+				break;
+
+			default:
+				break;
+		}
+	}
+
+done:
+	fclose(file);
+	if (!reader.error().empty())
+	{
+		fprintf(stderr, "%s: %s\n", opts.filename, reader.error().c_str());
+		return 1;
+	}
+	return 0;
+}
+
+
 int main(int argc, char *argv[])
 {
 	osd_file::error filerr;
@@ -559,6 +713,20 @@ int main(int argc, char *argv[])
 	if (parse_options(argc, argv, &opts))
 		return 1;
 
+	// binary traces have their own loop
+	if (opts.trace)
+	{
+		try
+		{
+			return trace_main(opts);
+		}
+		catch (emu_fatalerror &fatal)
+		{
+			fprintf(stderr, "%s\n", fatal.string());
+			return 1;
+		}
+	}
+
 	// load the file
 	filerr = util::core_file::load(opts.filename, &data, length);
 	if (filerr != osd_file::error::NONE)
@@ -604,22 +772,7 @@ int main(int argc, char *argv[])
 				numbytes = pcdelta >> opts.dasm->pcshift;
 
 			// force upper or lower
-			if (opts.lower)
-			{
-				std::transform(
-					std::begin(buffer),
-					std::end(buffer),
-					std::begin(buffer),
-					[](char c) { return tolower(c); });
-			}
-			else if (opts.upper)
-			{
-				std::transform(
-					std::begin(buffer),
-					std::end(buffer),
-					std::begin(buffer),
-					[](char c) { return toupper(c); });
-			}
+			transform_case(opts, buffer);
 
 			// round to the nearest display chunk
 			numbytes = ((numbytes + displaychunk - 1) / displaychunk) * displaychunk;
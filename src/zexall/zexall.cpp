@@ -35,7 +35,8 @@ public:
 		m_out_data(0),
 		m_out_req(0),
 		m_out_req_last(0),
-		m_out_ack(0)
+		m_out_ack(0),
+		m_start_ticks(0)
 	{
 	}
 
@@ -53,6 +54,7 @@ private:
 	uint8_t m_out_req; // byte written to 0xFFFE
 	uint8_t m_out_req_last; // old value at 0xFFFE before the most recent write
 	uint8_t m_out_ack; // byte written to 0xFFFC
+	osd_ticks_t m_start_ticks; // host time at reset, for the speed report
 	virtual void machine_reset() override;
 	std::string terminate_string;
 };
@@ -70,6 +72,7 @@ void zexall_state::machine_reset()
 	// rom is self-modifying, so need to refresh it on each run
 	// fill main ram with zexall code
 	memcpy(m_main_ram, zexall_program, 0x228a);
+	m_start_ticks = osd_ticks();
 }
 
 READ8_MEMBER( zexall_state::zexall_output_ack_r )
@@ -79,7 +82,14 @@ READ8_MEMBER( zexall_state::zexall_output_ack_r )
 	{
 		osd_printf_info("%c",m_out_data);
 		if (m_out_data != 10 && m_out_data != 13) terminate_string += m_out_data; else terminate_string = "";
-		if (terminate_string == "Tests complete") machine().schedule_exit();
+		if (terminate_string == "Tests complete")
+		{
+			// report how fast the core ran; run with -nothrottle to use this as a benchmark
+			double const seconds = double(osd_ticks() - m_start_ticks) / double(osd_ticks_per_second());
+			double const cycles = double(m_maincpu->total_cycles());
+			osd_printf_info("\n%.0f cycles in %.2f seconds (%.2f MHz)\n", cycles, seconds, cycles / seconds / 1000000.0);
+			machine().schedule_exit();
+		}
 		m_out_req_last = m_out_req;
 		m_out_ack++;
 	}
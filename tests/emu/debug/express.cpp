@@ -0,0 +1,107 @@
+#include "catch.hpp"
+
+#include "emu.h"
+#include "debug/express.h"
+
+
+namespace {
+
+u64 memory[0x100];
+
+expression_error::error_code memory_valid(void *param, const char *name, expression_space space)
+{
+	return expression_error::NONE;
+}
+
+u64 memory_read(void *param, const char *name, expression_space space, u32 address, int size, bool with_se)
+{
+	return memory[address & 0xff];
+}
+
+void memory_write(void *param, const char *name, expression_space space, u32 address, int size, u64 data, bool with_se)
+{
+	memory[address & 0xff] = data;
+}
+
+u64 sum(symbol_table &table, void *ref, int params, const u64 *param)
+{
+	u64 result = 0;
+	for (int index = 0; index < params; index++)
+		result = result * 10 + param[index];
+	return result;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("expressions evaluate symbols, memory and functions", "[emu][debug]")
+{
+	u64 a = 3, b = 5;
+	symbol_table table(nullptr);
+	table.add("a", symbol_table::READ_WRITE, &a);
+	table.add("b", symbol_table::READ_WRITE, &b);
+	table.add("k", 9);
+	table.add("sum", nullptr, 0, 4, sum);
+	table.configure_memory(nullptr, memory_valid, memory_read, memory_write);
+	memory[2] = 5;
+
+	parsed_expression expr(&table);
+	expr.parse("b@2 == 5 && a < 10");
+	REQUIRE(expr.execute() == 1);
+	a = 0x20;
+	REQUIRE(expr.execute() == 0);
+
+	// symbols are read when they are consumed, not when they are pushed
+	a = 1;
+	expr.parse("a + a++");
+	REQUIRE(expr.execute() == 3);
+	REQUIRE(a == 2);
+
+	expr.parse("b@(a + 1) = k, b@3 += sum(b)");
+	REQUIRE(expr.execute() == 9 + 5);
+	REQUIRE(memory[3] == 9 + 5);
+}
+
+
+TEST_CASE("copied expressions evaluate like the original", "[emu][debug]")
+{
+	u64 a = 3, b = 4;
+	symbol_table table(nullptr);
+	table.add("a", symbol_table::READ_WRITE, &a);
+	table.add("b", symbol_table::READ_WRITE, &b);
+	table.add("k", 9);
+
+	parsed_expression expr(&table);
+	expr.parse("(a + k) * b - a / 3");
+	REQUIRE(expr.execute() == 47);
+
+	parsed_expression copy(expr);
+	REQUIRE(copy.execute() == expr.execute());
+
+	parsed_expression assigned(&table);
+	assigned.parse("a == b");
+	assigned = expr;
+	REQUIRE(assigned.execute() == expr.execute());
+
+	b = 2;
+	REQUIRE(copy.execute() == 23);
+	REQUIRE(assigned.execute() == 23);
+}
+
+
+TEST_CASE("expression errors are reported at runtime", "[emu][debug]")
+{
+	u64 a = 0;
+	symbol_table table(nullptr);
+	table.add("a", symbol_table::READ_WRITE, &a);
+	table.add("k", 9);
+
+	parsed_expression expr(&table);
+	expr.parse("k / a");
+	REQUIRE_THROWS_AS(expr.execute(), expression_error);
+	a = 3;
+	REQUIRE(expr.execute() == 3);
+
+	expr.parse("k = 1");
+	REQUIRE_THROWS_AS(expr.execute(), expression_error);
+}
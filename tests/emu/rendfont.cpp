@@ -0,0 +1,92 @@
+#include "catch.hpp"
+
+#include "emu.h"
+#include "rendfont.h"
+
+#include <vector>
+
+
+namespace {
+
+//-------------------------------------------------
+//  glyph helpers
+//-------------------------------------------------
+
+void fill_glyph(bitmap_argb32 &glyph, u32 value)
+{
+	for (s32 y = 0; y < glyph.height(); y++)
+		for (s32 x = 0; x < glyph.width(); x++)
+			glyph.pix32(y, x) = value;
+}
+
+bool glyph_filled(bitmap_argb32 const &glyph, u32 value)
+{
+	for (s32 y = 0; y < glyph.height(); y++)
+		for (s32 x = 0; x < glyph.width(); x++)
+			if (glyph.pix32(y, x) != value)
+				return false;
+	return true;
+}
+
+bool glyph_on_page(render_font_atlas const &atlas, bitmap_argb32 const &glyph)
+{
+	for (std::size_t index = 0; index < atlas.page_count(); index++)
+	{
+		bitmap_argb32 const &page = atlas.page(index);
+		u32 const *const first = &page.pix32(0);
+		u32 const *const last = &page.pix32(page.height() - 1, page.width() - 1);
+		if (&glyph.pix32(0) >= first && &glyph.pix32(glyph.height() - 1, glyph.width() - 1) <= last)
+			return (glyph.rowpixels() == page.rowpixels()) && ((&glyph.pix32(0) - first) % page.rowpixels() + glyph.width()) <= page.width();
+	}
+	return false;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("Glyphs are packed apart on atlas pages", "[rendfont]")
+{
+	render_font_atlas atlas;
+	std::vector<bitmap_argb32> glyphs(40);
+	for (std::size_t i = 0; i < glyphs.size(); i++)
+	{
+		atlas.allocate(glyphs[i], 10 + (i % 7), 12 + (i % 5));
+		REQUIRE(glyph_on_page(atlas, glyphs[i]));
+		fill_glyph(glyphs[i], u32(i + 1));
+	}
+	for (std::size_t i = 0; i < glyphs.size(); i++)
+		REQUIRE(glyph_filled(glyphs[i], u32(i + 1)));
+}
+
+TEST_CASE("A glyph wider than the first atlas page gets a page of its own", "[rendfont]")
+{
+	render_font_atlas atlas;
+	bitmap_argb32 before, wide, after;
+	atlas.allocate(before, 10, 10);
+	atlas.allocate(wide, render_font_atlas::FIRST_PAGE_SIZE + 72, 10);
+	atlas.allocate(after, 10, 10);
+
+	REQUIRE(wide.width() == render_font_atlas::FIRST_PAGE_SIZE + 72);
+	REQUIRE(glyph_on_page(atlas, before));
+	REQUIRE(glyph_on_page(atlas, wide));
+	REQUIRE(glyph_on_page(atlas, after));
+	REQUIRE(atlas.page(0).width() == render_font_atlas::FIRST_PAGE_SIZE);
+	REQUIRE(atlas.page(1).width() > render_font_atlas::FIRST_PAGE_SIZE + 72);
+
+	// drawing the wide glyph mustn't overwrite its neighbours
+	fill_glyph(before, 1);
+	fill_glyph(after, 3);
+	fill_glyph(wide, 2);
+	REQUIRE(glyph_filled(before, 1));
+	REQUIRE(glyph_filled(wide, 2));
+	REQUIRE(glyph_filled(after, 3));
+}
+
+TEST_CASE("Empty glyphs take no atlas space", "[rendfont]")
+{
+	render_font_atlas atlas;
+	bitmap_argb32 glyph;
+	atlas.allocate(glyph, 0, 10);
+	REQUIRE(!glyph.valid());
+	REQUIRE(atlas.page_count() == 0);
+}
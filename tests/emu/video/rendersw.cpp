@@ -0,0 +1,192 @@
+#include "catch.hpp"
+
+#include "emu.h"
+#include "rendersw.hxx"
+
+#include <vector>
+
+
+namespace {
+
+typedef software_renderer<u32, 0,0,0, 16,8,0> test_renderer;
+typedef software_renderer<u32, 0,0,0, 16,8,0, false, true> test_renderer_bilinear;
+
+// same output format in a wider pixel, which never takes the SIMD span paths
+typedef software_renderer<u64, 0,0,0, 16,8,0> reference_renderer;
+typedef software_renderer<u64, 0,0,0, 16,8,0, false, true> reference_renderer_bilinear;
+
+//-------------------------------------------------
+//  primitive helpers
+//-------------------------------------------------
+
+render_primitive &add_primitive(simple_list<render_primitive> &list, render_primitive::primitive_type type, float x0, float y0, float x1, float y1, u32 flags)
+{
+	render_primitive &prim = list.append(*global_alloc(render_primitive));
+	prim.type = type;
+	prim.bounds.x0 = x0;
+	prim.bounds.y0 = y0;
+	prim.bounds.x1 = x1;
+	prim.bounds.y1 = y1;
+	prim.full_bounds = prim.bounds;
+	prim.color.a = prim.color.r = prim.color.g = prim.color.b = 1.0f;
+	prim.flags = flags;
+	prim.width = 1.0f;
+	memset(&prim.texture, 0, sizeof(prim.texture));
+	prim.texcoords.tl.u = prim.texcoords.bl.u = 0.0f;
+	prim.texcoords.tr.u = prim.texcoords.br.u = 1.0f;
+	prim.texcoords.tl.v = prim.texcoords.tr.v = 0.0f;
+	prim.texcoords.bl.v = prim.texcoords.br.v = 1.0f;
+	return prim;
+}
+
+void add_texture(render_primitive &prim, std::vector<u32> &texels, u32 width, u32 height)
+{
+	texels.resize(width * height);
+	for (u32 y = 0; y < height; y++)
+		for (u32 x = 0; x < width; x++)
+			texels[y * width + x] = rgb_t(0x40 + ((x * y) & 0xbf), x * 7, y * 5, (x ^ y) * 3);
+	prim.texture.base = &texels[0];
+	prim.texture.rowpixels = width;
+	prim.texture.width = width;
+	prim.texture.height = height;
+}
+
+void build_scene(simple_list<render_primitive> &list, std::vector<u32> &tex1, std::vector<u32> &tex2, u32 width, u32 height)
+{
+	float const w = float(width), h = float(height);
+
+	// opaque background and a translucent overlay
+	render_primitive &back = add_primitive(list, render_primitive::QUAD, 0.0f, 0.0f, w, h, PRIMFLAG_BLENDMODE(BLENDMODE_NONE));
+	back.color.r = 0.1f; back.color.g = 0.2f; back.color.b = 0.3f;
+	render_primitive &overlay = add_primitive(list, render_primitive::QUAD, w * 0.1f, h * 0.05f, w * 0.6f, h * 0.93f, PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+	overlay.color.a = 0.5f; overlay.color.g = 0.0f;
+
+	// a scaled screen partly off the top, so the bands have to step U/V past clipped rows
+	render_primitive &screen = add_primitive(list, render_primitive::QUAD, w * 0.2f, -h * 0.17f, w * 0.9f, h * 0.71f, PRIMFLAG_TEXFORMAT(TEXFORMAT_RGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_NONE));
+	add_texture(screen, tex1, 320, 240);
+
+	// artwork blended over everything
+	render_primitive &art = add_primitive(list, render_primitive::QUAD, w * 0.05f, h * 0.33f, w * 0.97f, h * 1.2f, PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+	add_texture(art, tex2, 97, 61);
+	render_primitive &glow = add_primitive(list, render_primitive::QUAD, w * 0.3f, h * 0.3f, w * 0.5f, h * 0.8f, PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_ADD));
+	glow.texture = art.texture;
+
+	// vectors crossing band boundaries, with and without antialiasing
+	add_primitive(list, render_primitive::LINE, 3.0f, 2.0f, w - 5.0f, h - 3.0f, PRIMFLAG_BLENDMODE(BLENDMODE_ADD));
+	add_primitive(list, render_primitive::LINE, w * 0.5f, 0.0f, w * 0.52f, h - 1.0f, PRIMFLAG_BLENDMODE(BLENDMODE_ADD));
+	render_primitive &beam = add_primitive(list, render_primitive::LINE, w - 7.5f, 4.25f, 11.5f, h * 0.8f, PRIMFLAG_BLENDMODE(BLENDMODE_ADD) | PRIMFLAG_ANTIALIAS(1));
+	beam.width = 2.5f;
+	render_primitive &steep = add_primitive(list, render_primitive::LINE, w * 0.7f, h - 2.0f, w * 0.75f, 1.5f, PRIMFLAG_BLENDMODE(BLENDMODE_ADD) | PRIMFLAG_ANTIALIAS(1));
+	steep.width = 1.5f;
+}
+
+void build_format_scene(simple_list<render_primitive> &list, std::vector<u32> &tex32, std::vector<u16> &pal16, std::vector<u16> &yuy16, std::vector<rgb_t> &palette, u32 width, u32 height)
+{
+	float const w = float(width), h = float(height);
+
+	add_primitive(list, render_primitive::QUAD, 0.0f, 0.0f, w, h, PRIMFLAG_BLENDMODE(BLENDMODE_NONE)).color.g = 0.5f;
+
+	// palettized and YUY sources, scaled
+	palette.resize(0x100);
+	for (u32 index = 0; index < palette.size(); index++)
+		palette[index] = rgb_t(index, index * 3, index * 5, index * 7);
+	pal16.resize(57 * 43);
+	for (u32 index = 0; index < pal16.size(); index++)
+		pal16[index] = (index * 13) & 0xff;
+	render_primitive &pal = add_primitive(list, render_primitive::QUAD, w * 0.02f, h * 0.03f, w * 0.47f, h * 0.49f, PRIMFLAG_TEXFORMAT(TEXFORMAT_PALETTE16) | PRIMFLAG_BLENDMODE(BLENDMODE_NONE));
+	pal.texture.base = &pal16[0];
+	pal.texture.rowpixels = pal.texture.width = 57;
+	pal.texture.height = 43;
+	pal.texture.palette = &palette[0];
+
+	yuy16.resize(64 * 37);
+	for (u32 index = 0; index < yuy16.size(); index++)
+		yuy16[index] = ((index * 37) & 0xff) << 8 | ((index * 11) & 0xff);
+	render_primitive &yuy = add_primitive(list, render_primitive::QUAD, w * 0.51f, h * 0.04f, w * 0.98f, h * 0.47f, PRIMFLAG_TEXFORMAT(TEXFORMAT_YUY16) | PRIMFLAG_BLENDMODE(BLENDMODE_NONE));
+	yuy.texture.base = &yuy16[0];
+	yuy.texture.rowpixels = yuy.texture.width = 64;
+	yuy.texture.height = 37;
+
+	// an unscaled screen, then unscaled and scaled artwork over it
+	render_primitive &screen = add_primitive(list, render_primitive::QUAD, 5.0f, h * 0.5f, 5.0f + 101.0f, h * 0.5f + 17.0f, PRIMFLAG_TEXFORMAT(TEXFORMAT_RGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_NONE));
+	add_texture(screen, tex32, 101, 17);
+	for (u32 index = 0; index < tex32.size(); index += 5)
+		tex32[index] &= 0x00ffffff;
+	render_primitive &art = add_primitive(list, render_primitive::QUAD, 7.0f, h * 0.5f + 3.0f, 7.0f + 101.0f, h * 0.5f + 20.0f, PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+	art.texture = screen.texture;
+	render_primitive &bezel = add_primitive(list, render_primitive::QUAD, w * 0.01f, h * 0.45f, w * 0.93f, h * 0.99f, PRIMFLAG_TEXFORMAT(TEXFORMAT_ARGB32) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA));
+	bezel.texture = screen.texture;
+}
+
+template <typename Renderer, typename Reference>
+void compare_spans(u32 width, u32 height)
+{
+	simple_list<render_primitive> list;
+	std::vector<u32> tex32;
+	std::vector<u16> pal16, yuy16;
+	std::vector<rgb_t> palette;
+	build_format_scene(list, tex32, pal16, yuy16, palette, width, height);
+
+	std::vector<u32> actual(width * height, 0xdeadbeef);
+	std::vector<u64> expected(width * height, 0xdeadbeef);
+	Renderer::draw_primitives(list.first(), &actual[0], width, height, width);
+	Reference::draw_primitives(list.first(), &expected[0], width, height, width);
+
+	u32 mismatches = 0;
+	for (u32 index = 0; index < actual.size(); index++)
+		if (actual[index] != expected[index])
+			mismatches++;
+	INFO(width << "x" << height);
+	REQUIRE(mismatches == 0);
+}
+
+template <typename Renderer>
+void compare_bands(osd_work_queue *queue, u32 width, u32 height, u32 bands)
+{
+	simple_list<render_primitive> list;
+	std::vector<u32> tex1, tex2;
+	build_scene(list, tex1, tex2, width, height);
+
+	u32 const pitch = width + 13;
+	std::vector<u32> single(pitch * height, 0xdeadbeef);
+	std::vector<u32> banded(pitch * height, 0xdeadbeef);
+	Renderer::draw_primitives(list.first(), &single[0], width, height, pitch);
+	Renderer::draw_primitives(list.first(), &banded[0], width, height, pitch, queue, bands);
+
+	u32 mismatches = 0;
+	for (u32 index = 0; index < single.size(); index++)
+		if (single[index] != banded[index])
+			mismatches++;
+	INFO(width << "x" << height << " in " << bands << " bands");
+	REQUIRE(mismatches == 0);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("banded software rendering matches a single pass", "[emu][video]")
+{
+	osd_work_queue *const queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	REQUIRE(queue != nullptr);
+
+	static const u32 sizes[][2] = { { 640, 480 }, { 1920, 1080 }, { 333, 251 }, { 64, 40 } };
+	for (auto const &size : sizes)
+		for (u32 bands : { 2, 3, 4, 7, 16, 64 })
+		{
+			compare_bands<test_renderer>(queue, size[0], size[1], bands);
+			compare_bands<test_renderer_bilinear>(queue, size[0], size[1], bands);
+		}
+
+	osd_work_queue_free(queue);
+}
+
+
+TEST_CASE("software rendering spans match the per-pixel loops", "[emu][video]")
+{
+	static const u32 sizes[][2] = { { 640, 480 }, { 333, 251 }, { 131, 67 } };
+	for (auto const &size : sizes)
+	{
+		compare_spans<test_renderer, reference_renderer>(size[0], size[1]);
+		compare_spans<test_renderer_bilinear, reference_renderer_bilinear>(size[0], size[1]);
+	}
+}
@@ -0,0 +1,104 @@
+#include "catch.hpp"
+
+#include "aviio.h"
+
+#include <cstdio>
+
+
+namespace {
+
+// flat areas, ramps and noise, so residuals cover the whole code table
+void fill_frame(bitmap_yuy16 &bitmap, int frame)
+{
+	uint32_t seed = 12345 + frame;
+	for (int y = 0; y < bitmap.height(); y++)
+		for (int x = 0; x < bitmap.width(); x++)
+		{
+			seed = seed * 1103515245 + 12345;
+			uint16_t pixel;
+			if (x < bitmap.width() / 3)
+				pixel = (((x / 16) * 0x23 + frame) << 8) | ((y / 8) * 0x11);
+			else if (x < 2 * bitmap.width() / 3)
+				pixel = ((x + y + frame) << 8) | ((x * 3) & 0xff);
+			else
+				pixel = seed >> 16;
+			bitmap.pix16(y, x) = pixel;
+		}
+}
+
+avi_file::movie_info huffyuv_info(int width, int height)
+{
+	avi_file::movie_info info;
+	memset(&info, 0, sizeof(info));
+	info.video_format = FORMAT_HFYU;
+	info.video_timescale = 60;
+	info.video_sampletime = 1;
+	info.video_width = width;
+	info.video_height = height;
+	info.video_depth = 16;
+	info.audio_samplebits = 16;
+	return info;
+}
+
+void round_trip(int width, int height)
+{
+	avi_file::movie_info const info = huffyuv_info(width, height);
+
+	static int const frames = 3;
+	char const *const filename = "avi_round_trip.avi";
+	{
+		avi_file::ptr file;
+		REQUIRE(avi_file::create(filename, info, file) == avi_file::error::NONE);
+		bitmap_yuy16 frame(width, height);
+		for (int framenum = 0; framenum < frames; framenum++)
+		{
+			fill_frame(frame, framenum);
+			REQUIRE(file->append_video_frame(frame) == avi_file::error::NONE);
+		}
+	}
+
+	{
+		avi_file::ptr file;
+		REQUIRE(avi_file::open(filename, file) == avi_file::error::NONE);
+		REQUIRE(file->get_movie_info().video_format == FORMAT_HFYU);
+		REQUIRE(file->get_movie_info().video_numsamples == frames);
+		bitmap_yuy16 expected(width, height), actual(width, height);
+		for (int framenum = 0; framenum < frames; framenum++)
+		{
+			fill_frame(expected, framenum);
+			REQUIRE(file->read_video_frame(framenum, actual) == avi_file::error::NONE);
+
+			int mismatches = 0;
+			for (int y = 0; y < height; y++)
+				for (int x = 0; x < width; x++)
+					if (actual.pix16(y, x) != expected.pix16(y, x))
+						mismatches++;
+			INFO(width << "x" << height << " frame " << framenum);
+			REQUIRE(mismatches == 0);
+		}
+	}
+	std::remove(filename);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("HuffYUV frames survive writing and reading back", "[util]")
+{
+	// a single slice, then frames split across several
+	round_trip(4, 4);
+	round_trip(36, 20);
+	round_trip(320, 240);
+	round_trip(720, 480);
+	round_trip(1920, 1080);
+}
+
+TEST_CASE("HuffYUV streams must have an even width", "[util]")
+{
+	// YUY2 packs pixels in pairs sharing a chroma sample
+	char const *const filename = "avi_odd_width.avi";
+	avi_file::ptr file;
+	REQUIRE(avi_file::create(filename, huffyuv_info(321, 240), file) == avi_file::error::UNSUPPORTED_VIDEO_FORMAT);
+	REQUIRE(!file);
+	std::remove(filename);
+}
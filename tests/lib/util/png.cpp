@@ -0,0 +1,78 @@
+#include "catch.hpp"
+
+#include "png.h"
+
+#include <cstdio>
+
+
+namespace {
+
+// a mixture of flat areas, gradients and noise, so every filter gets used,
+// or a handful of colours, which is written unfiltered
+void fill_bitmap(bitmap_argb32 &bitmap, bool few_colours)
+{
+	uint32_t seed = 12345;
+	for (int y = 0; y < bitmap.height(); y++)
+		for (int x = 0; x < bitmap.width(); x++)
+		{
+			seed = seed * 1103515245 + 12345;
+			uint32_t pixel;
+			if (x < bitmap.width() / 3)
+				pixel = ((x / 16) * 0x102030) ^ ((y / 8) * 0x030201);
+			else if (x < 2 * bitmap.width() / 3)
+				pixel = ((x & 0xff) << 16) | ((y & 0xff) << 8) | ((x + y) & 0xff);
+			else
+				pixel = seed >> 8;
+			if (few_colours)
+				pixel = (pixel & 0x0f) * 0x0f0f0f;
+			bitmap.pix32(y, x) = 0xff000000 | pixel;
+		}
+}
+
+void round_trip(int width, int height, bool few_colours)
+{
+	bitmap_argb32 source(width, height);
+	fill_bitmap(source, few_colours);
+
+	char const *const filename = "png_round_trip.png";
+	{
+		util::core_file::ptr file;
+		REQUIRE(util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, file) == osd_file::error::NONE);
+		REQUIRE(png_write_bitmap(*file, nullptr, source, 0, nullptr) == PNGERR_NONE);
+	}
+
+	bitmap_argb32 result;
+	{
+		util::core_file::ptr file;
+		REQUIRE(util::core_file::open(filename, OPEN_FLAG_READ, file) == osd_file::error::NONE);
+		REQUIRE(png_read_bitmap(*file, result) == PNGERR_NONE);
+	}
+	std::remove(filename);
+
+	INFO(width << "x" << height << (few_colours ? " with few colours" : ""));
+	REQUIRE(result.width() == width);
+	REQUIRE(result.height() == height);
+	int mismatches = 0;
+	for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+			if (result.pix32(y, x) != ((source.pix32(y, x) & 0x00ffffff) | 0xff000000))
+				mismatches++;
+	REQUIRE(mismatches == 0);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("PNG images survive writing and reading back", "[util]")
+{
+	// small enough to deflate in one stream, then large enough to be split into blocks
+	for (bool few_colours : { false, true })
+	{
+		round_trip(1, 1, few_colours);
+		round_trip(5, 3, few_colours);
+		round_trip(37, 21, few_colours);
+		round_trip(640, 480, few_colours);
+		round_trip(1920, 1080, few_colours);
+		round_trip(1001, 333, few_colours);
+	}
+}
@@ -0,0 +1,64 @@
+#include "catch.hpp"
+
+#include "tracefile.h"
+
+#include <cstdio>
+
+
+TEST_CASE("binary traces read back what was written", "[util]")
+{
+	FILE *const file = tmpfile();
+	REQUIRE(file != nullptr);
+
+	// enough instructions to span several blocks
+	uint8_t const opcodes[4] = { 0xc3, 0x00, 0x10, 0xff };
+	std::string const text = "a line of text\n";
+	{
+		util::trace_writer writer(*file);
+		writer.device(0, "z80", ":maincpu");
+		writer.register_name(0, "PC");
+		writer.opcode(0x1000, opcodes, nullptr, 4);
+		for (uint32_t index = 0; index < 200000; index++)
+		{
+			writer.register_value(0, index * 3);
+			writer.instruction(0x1000 + (index % 7) * 0x123 - (index & 1) * 0x800);
+			if (index % 5 == 0)
+				writer.memory_write(index & 3, index * 0x10001, ~uint64_t(index), 0xff);
+			if (index % 10000 == 0)
+				writer.text(text.c_str(), text.length());
+		}
+	}
+
+	rewind(file);
+	util::trace_reader reader(*file);
+	util::trace_entry entry;
+
+	REQUIRE(reader.next(entry));
+	REQUIRE(entry.type == util::trace_record::DEVICE);
+	REQUIRE(entry.text == "z80");
+	REQUIRE(entry.tag == ":maincpu");
+	REQUIRE(reader.next(entry));
+	REQUIRE(entry.type == util::trace_record::REGISTER_NAME);
+	REQUIRE(entry.text == "PC");
+	REQUIRE(reader.next(entry));
+	REQUIRE(entry.type == util::trace_record::OPCODE);
+	REQUIRE(entry.address == 0x1000);
+	REQUIRE(entry.opcodes == std::vector<uint8_t>(opcodes, opcodes + 4));
+	REQUIRE(entry.arguments == entry.opcodes);
+
+	uint32_t mismatches = 0;
+	for (uint32_t index = 0; index < 200000; index++)
+	{
+		mismatches += !reader.next(entry) || entry.type != util::trace_record::REGISTER || entry.index != 0 || entry.data != index * 3;
+		mismatches += !reader.next(entry) || entry.type != util::trace_record::INSTRUCTION || entry.address != uint64_t(0x1000 + (index % 7) * 0x123 - (index & 1) * 0x800);
+		if (index % 5 == 0)
+			mismatches += !reader.next(entry) || entry.type != util::trace_record::WRITE || entry.index != (index & 3) || entry.address != index * 0x10001 || entry.data != ~uint64_t(index) || entry.mask != 0xff;
+		if (index % 10000 == 0)
+			mismatches += !reader.next(entry) || entry.type != util::trace_record::TEXT || entry.text != text;
+	}
+	REQUIRE(mismatches == 0);
+	REQUIRE(!reader.next(entry));
+	REQUIRE(reader.error().empty());
+
+	fclose(file);
+}